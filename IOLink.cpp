@@ -58,23 +58,103 @@ ErrorCode IOLinkDevice::readDiagnostic(std::vector<uint8_t>& data) {
 // IOLinkMaster Implementation
 //-----------------------------------------------------------------------------
 
+constexpr uint32_t IOLinkMaster::AUTO_TIMEOUT;
+constexpr uint32_t IOLinkMaster::DEFAULT_RESPONSE_MARGIN_US;
+
+IOLinkMaster::IOLinkMaster(Transport& transport, Clock& clock)
+    : m_clock(&clock)
+    , m_eventCallbackId(EventBus::INVALID_SUBSCRIPTION)
+    , m_transmitQueue(false)
+    , m_receiveSpinUs(0)
+    , m_responseMarginUs(DEFAULT_RESPONSE_MARGIN_US)
+    , m_framing(Framing::SIMPLE)
+    , m_mSequenceConfig(MSEQ_TYPE_0) {
+    // Initialize the devices vector
+    m_devices.clear();
+    
+    addPort(transport);
+}
+
+#if defined(IOLINK_PLATFORM_CLEARCORE)
 IOLinkMaster::IOLinkMaster(SerialDriver& serialPort)
-    : m_serialPort(serialPort)
-    , m_eventCallback(nullptr) {
+    : m_ownedTransport(new ClearCoreTransport(serialPort))
+    , m_ownedClock(new ClearCoreClock())
+    , m_clock(m_ownedClock.get())
+    , m_eventCallbackId(EventBus::INVALID_SUBSCRIPTION)
+    , m_transmitQueue(false)
+    , m_receiveSpinUs(0)
+    , m_responseMarginUs(DEFAULT_RESPONSE_MARGIN_US)
+    , m_framing(Framing::SIMPLE)
+    , m_mSequenceConfig(MSEQ_TYPE_0) {
     // Initialize the devices vector
     m_devices.clear();
+    
+    addPort(*m_ownedTransport);
+}
+#endif
+
+uint8_t IOLinkMaster::addPort(Transport& transport) {
+    PortState state;
+    state.transport = &transport;
+    state.isduSegmentSent = false;
+    state.txLength = 0;
+    state.lastTxLength = 0;
+    state.lastTxTime = 0;
+    state.rxCount = 0;
+    m_ports.push_back(state);
+    return static_cast<uint8_t>(m_ports.size() - 1);
 }
 
 void IOLinkMaster::configure(uint32_t baudRate) {
-    // Configure the serial port for IO-Link communication
-    // Typically using 8 data bits, no parity, 1 stop bit
-    m_serialPort.Mode(SerialDriver::RS232);
-    m_serialPort.Speed(baudRate);
-    m_serialPort.Format(8, SerialDriver::NoParity, 1);
-    m_serialPort.FlowControl(SerialDriver::NoFlowControl);
+    m_timing = WireTiming(baudRate);
+    
+    // Configure the transport of every port for IO-Link communication
+    for (PortState& state : m_ports) {
+        state.transport->configure(baudRate);
+    }
+}
+
+Deadline IOLinkMaster::responseDeadline(size_t requestLength, size_t responseLength) {
+    return Deadline(*m_clock, m_timing.cycleNs(requestLength, responseLength) + m_responseMarginUs * 1000ULL);
+}
+
+uint64_t IOLinkMaster::getCycleTime(uint8_t port, size_t requestLength, size_t responseLength) const {
+    uint64_t cycleNs = m_timing.cycleNs(requestLength, responseLength) + m_responseMarginUs * 1000ULL;
+    
+    // The device may not accept cycles faster than its minimum cycle time (ms)
+    if (port < m_devices.size() && m_devices[port]) {
+        uint64_t minCycleNs = m_devices[port]->getMinCycleTime() * 1000000ULL;
+        if (minCycleNs > cycleNs) {
+            cycleNs = minCycleNs;
+        }
+    }
+    return cycleNs;
+}
+
+void IOLinkMaster::setTransmitQueue(bool enable) {
+    if (!enable) {
+        flush();
+    }
+    m_transmitQueue = enable;
+}
+
+void IOLinkMaster::flush() {
+    for (uint8_t port = 0; port < m_ports.size(); port++) {
+        flushPort(port);
+    }
+}
+
+ErrorCode IOLinkMaster::setFraming(Framing framing, const MSequenceConfig& config) {
+    if (!config.isValid()) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
     
-    // Enable the serial port
-    m_serialPort.PortOpen();
+    m_framing = framing;
+    m_mSequenceConfig = config;
+    for (PortState& state : m_ports) {
+        state.decoder.reset();
+    }
+    return ErrorCode::NONE;
 }
 
 ErrorCode IOLinkMaster::activatePort(uint8_t port, OperationMode mode) {
@@ -84,10 +164,9 @@ ErrorCode IOLinkMaster::activatePort(uint8_t port, OperationMode mode) {
     
     // Wakeup sequence for IO-Link device
     // Send wakeup pattern (5+ consecutive 0 bits)
-    uint8_t wakeupPattern = 0x00;
-    for (int i = 0; i < 10; i++) {
-        m_serialPort.SendChar(wakeupPattern);
-    }
+    uint8_t wakeupPattern[10] = {};
+    flushPort(port);
+    m_ports[port].transport->write(wakeupPattern, sizeof(wakeupPattern));
     
     // Wait for device to respond
     // TODO: Implement proper IO-Link device discovery and activation
@@ -116,9 +195,23 @@ ErrorCode IOLinkMaster::scanForDevices() {
     // 3. Identify devices and their capabilities
     // TODO: Implement proper IO-Link device discovery
     
-    // For now, let's just create a dummy device for testing
-    auto dummyDevice = std::make_shared<IOLinkDevice>(1, 0x12345678, 0x87654321);
-    m_devices.push_back(dummyDevice);
+    // For now, let's just create a dummy device on every port for testing
+    for (PortState& state : m_ports) {
+        auto dummyDevice = std::make_shared<IOLinkDevice>(1, 0x12345678, 0x87654321);
+        m_devices.push_back(dummyDevice);
+        
+        // Output frames are rebuilt on the first write to each port
+        state.decoder.reset();
+        state.outputFrame = FrameTemplate();
+        state.isdu = IsduTransfer();
+        state.isduSegmentSent = false;
+        state.txLength = 0;
+        state.lastTxLength = 0;
+        state.lastTxTime = 0;
+        for (FrameQueue& queue : state.rxQueues) {
+            queue.clear();
+        }
+    }
     
     return ErrorCode::NONE;
 }
@@ -131,171 +224,608 @@ std::shared_ptr<IOLinkDevice> IOLinkMaster::getDevice(uint8_t port) {
 }
 
 ErrorCode IOLinkMaster::sendMessage(uint8_t port, MessageType type, const std::vector<uint8_t>& data) {
+    return sendMessage(port, type, data.data(), data.size());
+}
+
+ErrorCode IOLinkMaster::sendMessage(uint8_t port, MessageType type, const uint8_t* data, size_t length) {
     if (port >= m_devices.size()) {
         return ErrorCode::INVALID_PARAMETER;
     }
     
-    // Build IO-Link message
-    std::vector<uint8_t> message = buildIOLinkMessage(type, data);
+    if (m_framing != Framing::SIMPLE) {
+        return ErrorCode::NOT_SUPPORTED;
+    }
+    
+    // Cyclic process data goes through the cached per-port frame
+    if (type == MessageType::PROCESS_DATA) {
+        return writeProcessData(port, data, length);
+    }
     
-    // Send over serial port
-    for (uint8_t byte : message) {
-        m_serialPort.SendChar(byte);
+    // Build IO-Link message (on the stack, no heap allocation)
+    uint8_t message[MAX_FRAME_LENGTH];
+    size_t messageLength = buildIOLinkMessage(type, data, length, message, sizeof(message));
+    if (messageLength == 0) {
+        return ErrorCode::INVALID_PARAMETER;
     }
     
+    discardReplies(port, type);
+    transmit(port, message, messageLength);
+    
     return ErrorCode::NONE;
 }
 
 ErrorCode IOLinkMaster::receiveMessage(uint8_t port, MessageType type, std::vector<uint8_t>& data, uint32_t timeout) {
+    FrameView frame;
+    ErrorCode result = receiveMessage(port, type, frame, timeout);
+    if (result == ErrorCode::NONE) {
+        data.assign(frame.data, frame.data + frame.length);
+    }
+    return result;
+}
+
+ErrorCode IOLinkMaster::receiveMessage(uint8_t port, MessageType type, FrameView& frame, uint32_t timeout) {
+    if (timeout == AUTO_TIMEOUT) {
+        return receiveFrame(port, type, frame, Deadline(), true);
+    }
+    return receiveFrame(port, type, frame, Deadline::fromMilliseconds(*m_clock, timeout), false);
+}
+
+ErrorCode IOLinkMaster::receiveMessage(uint8_t port, MessageType type, FrameView& frame, const Deadline& deadline) {
+    return receiveFrame(port, type, frame, deadline, false);
+}
+
+ErrorCode IOLinkMaster::receiveFrame(uint8_t port, MessageType type, FrameView& frame, Deadline deadline, bool extend) {
     if (port >= m_devices.size()) {
         return ErrorCode::INVALID_PARAMETER;
     }
+    if (m_framing != Framing::SIMPLE) {
+        return ErrorCode::NOT_SUPPORTED;
+    }
     
-    // Wait for response with timeout
-    uint32_t startTime = Milliseconds();
-    std::vector<uint8_t> rawData;
+    // The request may still be queued
+    flushPort(port);
     
-    while ((Milliseconds() - startTime) < timeout) {
-        if (m_serialPort.BytesAvailable() > 0) {
-            // Read available data
-            while (m_serialPort.BytesAvailable() > 0) {
-                rawData.push_back(m_serialPort.ReadChar());
-            }
-            
-            // Parse IO-Link message
-            MessageType receivedType;
-            std::vector<uint8_t> payload;
-            ErrorCode result = parseIOLinkMessage(rawData, receivedType, payload);
-            
-            if (result == ErrorCode::NONE && receivedType == type) {
-                data = payload;
-                return ErrorCode::NONE;
-            }
+    // Derived deadline: the request ends its wire time after it was
+    // written; the response delay and the reply's wire time follow the
+    // bytes still expected
+    PortState& state = m_ports[port];
+    Deadline requestEnd;
+    uint32_t rxStart = state.rxCount;
+    if (extend) {
+        requestEnd = Deadline::at(*m_clock, state.lastTxTime + m_timing.masterMessageNs(state.lastTxLength) +
+                                                m_responseMarginUs * 1000ULL);
+    }
+    
+    // Wait for response until the deadline
+    while (true) {
+        // Decode newly received bytes; partial frames are kept by the
+        // decoder and frames of other types are queued for their readers
+        if (nextFrame(port, type, frame)) {
+            return ErrorCode::NONE;
+        }
+        
+        if (extend) {
+            deadline = requestEnd;
+            deadline.extend(m_timing.deviceResponseNs(state.rxCount - rxStart + state.decoder.missing()));
+        }
+        if (deadline.isExpired()) {
+            break;
         }
         
-        // Give other tasks a chance to run
-        delay(1);
+        // Sleep until more bytes arrive rather than for a fixed interval
+        waitForData(port, deadline);
     }
     
     // Timeout occurred
     return ErrorCode::TIMEOUT;
 }
 
-void IOLinkMaster::registerEventCallback(EventCallback callback) {
-    m_eventCallback = callback;
+ErrorCode IOLinkMaster::readProcessData(uint8_t port, FrameView& frame, uint32_t timeout) {
+    return receiveMessage(port, MessageType::PROCESS_DATA, frame, timeout);
 }
 
-void IOLinkMaster::processEvents() {
-    // Check for incoming event messages
-    if (m_serialPort.BytesAvailable() > 0) {
-        std::vector<uint8_t> rawData;
-        
-        // Read available data
-        while (m_serialPort.BytesAvailable() > 0) {
-            rawData.push_back(m_serialPort.ReadChar());
+ErrorCode IOLinkMaster::writeProcessData(uint8_t port, const uint8_t* data, size_t length) {
+    if (port >= m_devices.size()) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    
+    if (m_framing != Framing::SIMPLE) {
+        return ErrorCode::NOT_SUPPORTED;
+    }
+    
+    // Header and checksum are only rebuilt when the frame layout changes
+    FrameTemplate& frame = m_ports[port].outputFrame;
+    if (frame.matches(MessageType::PROCESS_DATA, length)) {
+        frame.update(data, length);
+    } else if (!frame.build<MessageType::PROCESS_DATA>(data, length)) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    
+    discardReplies(port, MessageType::PROCESS_DATA);
+    transmit(port, frame.data(), frame.size());
+    
+    return ErrorCode::NONE;
+}
+
+ErrorCode IOLinkMaster::patchProcessData(uint8_t port, size_t offset, const uint8_t* data, size_t length) {
+    if (port >= m_devices.size()) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    
+    if (m_framing != Framing::SIMPLE) {
+        return ErrorCode::NOT_SUPPORTED;
+    }
+    
+    FrameTemplate& frame = m_ports[port].outputFrame;
+    if (!frame.patch(offset, data, length)) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    
+    discardReplies(port, MessageType::PROCESS_DATA);
+    transmit(port, frame.data(), frame.size());
+    
+    return ErrorCode::NONE;
+}
+
+ErrorCode IOLinkMaster::startParameterRead(uint8_t port, uint16_t index, uint8_t subindex) {
+    if (port >= m_devices.size()) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    
+    m_ports[port].isduDeadline = Deadline::fromMilliseconds(*m_clock, ISDU_TIMEOUT_MS);
+    m_ports[port].isduSegmentSent = false;
+    return m_ports[port].isdu.startRead(index, subindex);
+}
+
+ErrorCode IOLinkMaster::startParameterWrite(uint8_t port, uint16_t index, uint8_t subindex, const uint8_t* data, size_t length) {
+    if (port >= m_devices.size()) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    
+    m_ports[port].isduDeadline = Deadline::fromMilliseconds(*m_clock, ISDU_TIMEOUT_MS);
+    m_ports[port].isduSegmentSent = false;
+    return m_ports[port].isdu.startWrite(index, subindex, data, length);
+}
+
+ErrorCode IOLinkMaster::serviceParameter(uint8_t port, uint32_t timeout) {
+    if (port >= m_devices.size()) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    
+    PortState& state = m_ports[port];
+    if (!state.isdu.isBusy()) {
+        return state.isdu.getResult();
+    }
+    
+    // Give up on devices that stay busy too long
+    if (state.isduDeadline.isExpired()) {
+        state.isdu.abort(ErrorCode::TIMEOUT);
+        return ErrorCode::TIMEOUT;
+    }
+    
+    // Exchange one segment; a lost reply repeats the same segment next cycle
+    uint8_t segment[1 + ISDU_SEGMENT_LENGTH];
+    size_t length = state.isdu.nextRequest(segment, sizeof(segment));
+    ErrorCode result = sendMessage(port, MessageType::PARAMETER, segment, length);
+    if (result != ErrorCode::NONE) {
+        return result;
+    }
+    
+    FrameView reply;
+    result = receiveMessage(port, MessageType::PARAMETER, reply, timeout);
+    if (result != ErrorCode::NONE) {
+        return result;
+    }
+    
+    return state.isdu.onResponse(reply.data, reply.length);
+}
+
+ErrorCode IOLinkMaster::pollParameter(uint8_t port) {
+    if (port >= m_devices.size()) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    
+    PortState& state = m_ports[port];
+    if (!state.isdu.isBusy()) {
+        return state.isdu.getResult();
+    }
+    
+    if (state.isduDeadline.isExpired()) {
+        state.isdu.abort(ErrorCode::TIMEOUT);
+        return ErrorCode::TIMEOUT;
+    }
+    
+    if (state.isduSegmentSent) {
+        // Take the reply without waiting
+        FrameView reply;
+        ErrorCode result = receiveMessage(port, MessageType::PARAMETER, reply, Deadline(*m_clock, 0));
+        if (result == ErrorCode::TIMEOUT) {
+            if (!state.isduSegmentDeadline.isExpired()) {
+                return ErrorCode::NONE;
+            }
+            
+            // Lost reply: the next call repeats the segment
+            state.isduSegmentSent = false;
+            return ErrorCode::TIMEOUT;
         }
         
-        // Parse IO-Link message
-        MessageType receivedType;
-        std::vector<uint8_t> payload;
-        ErrorCode result = parseIOLinkMessage(rawData, receivedType, payload);
-        
-        // If it's an event message and we have a callback, invoke it
-        if (result == ErrorCode::NONE && receivedType == MessageType::EVENT && m_eventCallback) {
-            // Determine the port from the message
-            // For now, assume port 0
-            uint8_t port = 0;
-            m_eventCallback(port, payload);
+        state.isduSegmentSent = false;
+        if (result != ErrorCode::NONE) {
+            return result;
+        }
+        result = state.isdu.onResponse(reply.data, reply.length);
+        if (result != ErrorCode::NONE || !state.isdu.isBusy()) {
+            return result;
         }
     }
+    
+    // Send the next segment right away, the device is waiting for it
+    uint8_t segment[1 + ISDU_SEGMENT_LENGTH];
+    size_t length = state.isdu.nextRequest(segment, sizeof(segment));
+    ErrorCode result = sendMessage(port, MessageType::PARAMETER, segment, length);
+    if (result != ErrorCode::NONE) {
+        return result;
+    }
+    
+    // The reply carries at most one segment
+    state.isduSegmentSent = true;
+    state.isduSegmentDeadline = responseDeadline(FRAME_OVERHEAD + length, FRAME_OVERHEAD + 1 + ISDU_SEGMENT_LENGTH);
+    return ErrorCode::NONE;
 }
 
-ErrorCode IOLinkMaster::parseIOLinkMessage(const std::vector<uint8_t>& rawData, MessageType& type, std::vector<uint8_t>& payload) {
-    // Simple IO-Link message parsing
-    // Format: [START_BYTE] [TYPE] [LENGTH] [PAYLOAD] [CHECKSUM]
+bool IOLinkMaster::isParameterBusy(uint8_t port) const {
+    return port < m_ports.size() && m_ports[port].isdu.isBusy();
+}
+
+ErrorCode IOLinkMaster::getParameterResult(uint8_t port, const uint8_t*& data, size_t& length) const {
+    if (port >= m_ports.size()) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
     
-    if (rawData.size() < 4) {
-        return ErrorCode::COMMUNICATION_ERROR;
+    const IsduTransfer& isdu = m_ports[port].isdu;
+    data = isdu.getData();
+    length = isdu.getDataLength();
+    return isdu.getResult();
+}
+
+ErrorCode IOLinkMaster::exchangeMSequence(uint8_t port, const MasterMessage& request, DeviceMessage& response, uint32_t timeout) {
+    if (port >= m_devices.size()) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    if (m_framing != Framing::M_SEQUENCE) {
+        return ErrorCode::NOT_SUPPORTED;
+    }
+    
+    uint8_t message[MSEQ_MAX_LENGTH];
+    size_t messageLength = encodeMasterMessage(m_mSequenceConfig, request, message, sizeof(message));
+    if (messageLength == 0) {
+        return ErrorCode::INVALID_PARAMETER;
     }
     
-    const uint8_t START_BYTE = 0xA5;
+    // Discard stale input so the reply lines up with this request
+    Transport& transport = *m_ports[port].transport;
+    discardInput(port);
     
-    // Check start byte
-    if (rawData[0] != START_BYTE) {
-        return ErrorCode::COMMUNICATION_ERROR;
+    // The reply length is fixed by the M-sequence type
+    size_t expected = m_mSequenceConfig.deviceLength(request.read);
+    if (expected > sizeof(m_mSequenceReply)) {
+        return ErrorCode::INVALID_PARAMETER;
     }
+    size_t received = 0;
+    Deadline deadline = (timeout == AUTO_TIMEOUT)
+        ? responseDeadline(messageLength, expected)
+        : Deadline::fromMilliseconds(*m_clock, timeout);
     
-    // Extract message type
-    uint8_t typeValue = rawData[1];
-    switch (typeValue) {
-        case 0x01: type = MessageType::PROCESS_DATA; break;
-        case 0x02: type = MessageType::PARAMETER; break;
-        case 0x03: type = MessageType::DIAGNOSTIC; break;
-        case 0x04: type = MessageType::EVENT; break;
-        default: return ErrorCode::COMMUNICATION_ERROR;
+    transmit(port, message, messageLength);
+    flushPort(port);
+    
+    while (true) {
+        if (received < expected) {
+            received += transport.read(m_mSequenceReply + received, expected - received);
+        }
+        if (received == expected) {
+            break;
+        }
+        if (deadline.isExpired()) {
+            return ErrorCode::TIMEOUT;
+        }
+        
+        waitForData(port, deadline);
     }
     
-    // Extract payload length
-    uint8_t length = rawData[2];
-    if (rawData.size() < length + 4) {
-        return ErrorCode::COMMUNICATION_ERROR;
+    return decodeDeviceMessage(m_mSequenceConfig, request.read, m_mSequenceReply, received, response);
+}
+
+void IOLinkMaster::registerEventCallback(EventCallback callback) {
+    m_eventBus.unsubscribe(m_eventCallbackId);
+    m_eventCallbackId = EventBus::INVALID_SUBSCRIPTION;
+    if (!callback) {
+        return;
     }
     
-    // Extract payload
-    payload.clear();
-    for (uint8_t i = 0; i < length; i++) {
-        payload.push_back(rawData[3 + i]);
+    m_eventCallbackId = m_eventBus.subscribe(EventFilter(), [callback](const Event& event) {
+        std::vector<uint8_t> eventData(event.data, event.data + event.length);
+        callback(event.port, eventData);
+    });
+}
+
+void IOLinkMaster::registerFrameCallback(FrameCallback callback) {
+    m_frameCallback = callback;
+}
+
+ErrorCode IOLinkMaster::servicePort(uint8_t port) {
+    if (port >= m_devices.size()) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    if (m_framing != Framing::SIMPLE) {
+        return ErrorCode::NOT_SUPPORTED;
     }
     
-    // Verify checksum (simple XOR)
-    uint8_t checksum = rawData[3 + length];
-    uint8_t calculatedChecksum = START_BYTE ^ typeValue ^ length;
-    for (uint8_t byte : payload) {
-        calculatedChecksum ^= byte;
+    // Frames queued by earlier receive calls go first
+    PortState& state = m_ports[port];
+    for (size_t index = 0; index < MESSAGE_TYPE_COUNT; index++) {
+        FrameView frame;
+        frame.type = static_cast<MessageType>(index);
+        while (state.rxQueues[index].pop(frame.data, frame.length)) {
+            if (frame.type == MessageType::EVENT) {
+                dispatchEvent(port, frame);
+            } else if (m_frameCallback) {
+                m_frameCallback(port, frame);
+            }
+        }
     }
     
-    if (checksum != calculatedChecksum) {
-        return ErrorCode::COMMUNICATION_ERROR;
+    // Drain the transport, dispatching every complete frame
+    while (pollFrame(port)) {
+        const FrameDecoder& decoder = state.decoder;
+        if (decoder.getType() == MessageType::EVENT) {
+            dispatchEvent(port, decoder.getFrame());
+        } else if (m_frameCallback) {
+            m_frameCallback(port, decoder.getFrame());
+        }
     }
     
     return ErrorCode::NONE;
 }
 
-std::vector<uint8_t> IOLinkMaster::buildIOLinkMessage(MessageType type, const std::vector<uint8_t>& payload) {
-    std::vector<uint8_t> message;
+void IOLinkMaster::processEvents() {
+    // Check every port for event messages, including those received
+    // while a receive call waited for another frame type; other frames
+    // stay queued for their readers
+    for (uint8_t port = 0; port < m_ports.size(); port++) {
+        FrameView frame;
+        while (nextFrame(port, MessageType::EVENT, frame)) {
+            dispatchEvent(port, frame);
+        }
+    }
+}
+
+void IOLinkMaster::discardInput(uint8_t port) {
+    if (port >= m_ports.size()) {
+        return;
+    }
     
-    const uint8_t START_BYTE = 0xA5;
+    PortState& state = m_ports[port];
+    uint8_t scratch[MAX_FRAME_LENGTH];
+    while (state.transport->read(scratch, sizeof(scratch)) > 0) {
+        // Dropped
+    }
+    state.decoder.reset();
+}
+
+uint32_t IOLinkMaster::getDroppedFrames(uint8_t port) const {
+    if (port >= m_ports.size()) {
+        return 0;
+    }
     
-    // Add start byte
-    message.push_back(START_BYTE);
+    uint32_t dropped = 0;
+    for (const FrameQueue& queue : m_ports[port].rxQueues) {
+        dropped += queue.getDropCount();
+    }
+    return dropped;
+}
+
+void IOLinkMaster::transmit(uint8_t port, const uint8_t* frame, size_t length) {
+    PortState& state = m_ports[port];
     
-    // Add message type
-    uint8_t typeValue;
-    switch (type) {
-        case MessageType::PROCESS_DATA: typeValue = 0x01; break;
-        case MessageType::PARAMETER: typeValue = 0x02; break;
-        case MessageType::DIAGNOSTIC: typeValue = 0x03; break;
-        case MessageType::EVENT: typeValue = 0x04; break;
-        default: typeValue = 0x01; break;
+    if (m_transmitQueue) {
+        if (state.txLength + length > sizeof(state.txBuffer)) {
+            flushPort(port);
+        }
+        if (length <= sizeof(state.txBuffer)) {
+            memcpy(state.txBuffer + state.txLength, frame, length);
+            state.txLength += length;
+            return;
+        }
     }
-    message.push_back(typeValue);
     
-    // Add payload length
-    message.push_back(static_cast<uint8_t>(payload.size()));
+    // Send the whole frame with one bulk write
+    state.lastTxTime = m_clock->nanoseconds();
+    state.transport->write(frame, length);
+    state.lastTxLength = length;
+}
+
+void IOLinkMaster::flushPort(uint8_t port) {
+    PortState& state = m_ports[port];
+    if (state.txLength > 0) {
+        state.lastTxTime = m_clock->nanoseconds();
+        state.transport->write(state.txBuffer, state.txLength);
+        state.lastTxLength = state.txLength;
+        state.txLength = 0;
+    }
+}
+
+void IOLinkMaster::waitForData(uint8_t port, const Deadline& deadline) {
+    if (port >= m_ports.size()) {
+        return;
+    }
+    
+    Transport& transport = *m_ports[port].transport;
+    
+    // Optional spin phase: a reply due within microseconds is picked up
+    // without the wakeup latency of blocking
+    if (m_receiveSpinUs > 0) {
+        Deadline spinEnd = Deadline::fromMicroseconds(*m_clock, m_receiveSpinUs);
+        while (!spinEnd.isExpired() && !deadline.isExpired()) {
+            if (transport.available() > 0) {
+                return;
+            }
+        }
+    }
+    
+    uint32_t remaining = deadline.remainingMicroseconds();
+    if (remaining == 0) {
+        return;
+    }
+    
+    ErrorCode result = transport.waitReadable(remaining);
+    if (result != ErrorCode::NONE && result != ErrorCode::TIMEOUT) {
+        // Transport cannot wait: give other tasks a chance to run
+        m_clock->delayMicroseconds(remaining < 1000 ? remaining : 1000);
+    }
+}
+
+bool IOLinkMaster::pollFrame(uint8_t port) {
+    PortState& state = m_ports[port];
+    
+    // Bytes left over from a previous read may already hold a frame
+    if (state.decoder.next()) {
+        return true;
+    }
+    
+    // Read straight into the decoder buffer, one bulk read per chunk
+    while (true) {
+        size_t space;
+        uint8_t* buffer = state.decoder.writeBuffer(space);
+        size_t count = (space > 0) ? state.transport->read(buffer, space) : 0;
+        if (count == 0) {
+            break;
+        }
+        state.decoder.commit(count);
+        state.rxCount += static_cast<uint32_t>(count);
+        if (state.decoder.next()) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+bool IOLinkMaster::nextFrame(uint8_t port, MessageType type, FrameView& frame) {
+    PortState& state = m_ports[port];
+    
+    FrameQueue& queue = state.rxQueues[static_cast<size_t>(type)];
+    if (queue.pop(frame.data, frame.length)) {
+        frame.type = type;
+        return true;
+    }
+    
+    if (type == MessageType::PROCESS_DATA && readProcessDataFrame(port, frame)) {
+        return true;
+    }
+    
+    while (pollFrame(port)) {
+        const FrameDecoder& decoder = state.decoder;
+        if (decoder.getType() == type) {
+            frame = decoder.getFrame();
+            return true;
+        }
+        
+        // Keep the frame for the reader of its type
+        state.rxQueues[static_cast<size_t>(decoder.getType())].push(decoder.getPayload(), decoder.getPayloadLength());
+    }
     
-    // Add payload
-    message.insert(message.end(), payload.begin(), payload.end());
+    return false;
+}
+
+bool IOLinkMaster::readProcessDataFrame(uint8_t port, FrameView& frame) {
+    PortState& state = m_ports[port];
+    if (!state.decoder.empty()) {
+        return false;
+    }
+    
+    // A process data reply normally arrives whole in one read: check it
+    // in one pass instead of stepping the parser through it. The bytes
+    // are not committed, so the next read reuses the area (as it would
+    // after the decoder returned the frame).
+    size_t space;
+    uint8_t* buffer = state.decoder.writeBuffer(space);
+    size_t count = state.transport->read(buffer, space);
+    if (count == 0) {
+        return false;
+    }
+    state.rxCount += static_cast<uint32_t>(count);
+    if (decodeFrame<MessageType::PROCESS_DATA>(buffer, count, frame)) {
+        return true;
+    }
     
-    // Calculate and add checksum (simple XOR)
-    uint8_t checksum = START_BYTE ^ typeValue ^ static_cast<uint8_t>(payload.size());
-    for (uint8_t byte : payload) {
-        checksum ^= byte;
+    // Partial frame, several frames or another type: leave it to the parser
+    state.decoder.commit(count);
+    return false;
+}
+
+void IOLinkMaster::discardReplies(uint8_t port, MessageType type) {
+    if (type == MessageType::EVENT) {
+        return;
     }
-    message.push_back(checksum);
     
+    // Drop the frames of the type, decoded (no read) or already queued:
+    // they answer earlier requests (e.g. a reply that came in after its
+    // receive timed out). Their queue is not pushed to, so a reply popped
+    // from it stays valid for a callback that sends the next request
+    PortState& state = m_ports[port];
+    while (state.decoder.next()) {
+        if (state.decoder.getType() == type) {
+            continue;
+        }
+        state.rxQueues[static_cast<size_t>(state.decoder.getType())].push(state.decoder.getPayload(),
+                                                                           state.decoder.getPayloadLength());
+    }
+    state.rxQueues[static_cast<size_t>(type)].clear();
+}
+
+void IOLinkMaster::dispatchEvent(uint8_t port, const FrameView& frame) {
+    Event event;
+    decodeEvent(port, frame.data, frame.length, event);
+    m_eventBus.publish(event);
+}
+
+ErrorCode IOLinkMaster::parseIOLinkMessage(const std::vector<uint8_t>& rawData, MessageType& type, std::vector<uint8_t>& payload) {
+    FrameView frame;
+    ErrorCode result = parseIOLinkMessage(rawData.data(), rawData.size(), frame);
+    if (result == ErrorCode::NONE) {
+        type = frame.type;
+        payload.assign(frame.data, frame.data + frame.length);
+    }
+    return result;
+}
+
+ErrorCode IOLinkMaster::parseIOLinkMessage(const uint8_t* rawData, size_t length, FrameView& frame) {
+    // Simple IO-Link message parsing
+    // Format: [START_BYTE] [TYPE] [LENGTH] [PAYLOAD] [CHECKSUM]
+    // Leading noise and corrupted frames are skipped up to the first valid frame
+    FrameParser parser(rawData, length);
+    if (!parser.next()) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+    
+    // The frame references rawData, no payload copy is made
+    frame = parser.getFrame();
+    
+    return ErrorCode::NONE;
+}
+
+std::vector<uint8_t> IOLinkMaster::buildIOLinkMessage(MessageType type, const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> message(payload.size() + FRAME_OVERHEAD);
+    message.resize(buildIOLinkMessage(type, payload.data(), payload.size(), message.data(), message.size()));
     return message;
 }
 
+size_t IOLinkMaster::buildIOLinkMessage(MessageType type, const uint8_t* payload, size_t length, uint8_t* buffer, size_t bufferSize) {
+    // Format: [START_BYTE] [TYPE] [LENGTH] [PAYLOAD] [CHECKSUM]
+    return encodeFrame(type, payload, length, buffer, bufferSize);
+}
+
 //-----------------------------------------------------------------------------
 // IOLinkIODD Implementation
 //-----------------------------------------------------------------------------
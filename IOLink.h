@@ -1,71 +1,335 @@
 /**
- * @file IOLinkTemperatureSensor.h
- * @brief Implementation of an IO-Link temperature sensor
- * 
- * This file demonstrates how to extend the IOLinkDevice class
- * to implement a specific type of IO-Link device (temperature sensor).
+ * @file IOLink.h
+ * @brief IO-Link Protocol Implementation for Teknic ClearCore
+ *
+ * This file declares the IO-Link master, the generic IO-Link device
+ * and the IODD parser used to communicate with IO-Link devices
+ * (IEC 61131-9) from the ClearCore controller.
  */
 
-#ifndef IOLINK_TEMPERATURE_SENSOR_H
-#define IOLINK_TEMPERATURE_SENSOR_H
+#ifndef IOLINK_H
+#define IOLINK_H
 
-#include "IOLink.h"
+#include "IOLinkConfig.h"
+#include "IOLinkTypes.h"
+#include "IOLinkTransport.h"
+#include "IOLinkFrame.h"
+#include "IOLinkMSequence.h"
+#include "IOLinkISDU.h"
+#include "IOLinkTiming.h"
+#include "IOLinkEvent.h"
+#if defined(IOLINK_PLATFORM_CLEARCORE)
+#include "IOLinkClearCore.h"
+#endif
+#include <stdint.h>
+#include <functional>
+#include <memory>
+#include <vector>
 
 namespace IOLink {
 
+// Callback invoked for events received from a device
+using EventCallback = std::function<void(uint8_t port, const std::vector<uint8_t>& eventData)>;
+
+// Callback invoked for other frames decoded by IOLinkMaster::servicePort()
+// (the frame references the receive buffer and is only valid during the call)
+using FrameCallback = std::function<void(uint8_t port, const FrameView& frame)>;
+
 /**
- * @class TemperatureSensor
- * @brief Implementation of an IO-Link temperature sensor device
- * 
- * This class extends IOLinkDevice to implement a temperature sensor
- * with specific process data format and parameter access.
+ * @enum Framing
+ * @brief Message framing used by the master on the wire
  */
-class TemperatureSensor : public IOLinkDevice {
+enum class Framing {
+    SIMPLE,         // [0xA5] [TYPE] [LENGTH] [PAYLOAD] [XOR] frames (sendMessage/receiveMessage)
+    M_SEQUENCE      // IEC 61131-9 M-sequences (exchangeMSequence)
+};
+
+/**
+ * @class IOLinkDevice
+ * @brief Base class for IO-Link devices
+ *
+ * Derive from this class to implement specific device types
+ * (see IOLinkTemperatureSensor.h for an example).
+ */
+class IOLinkDevice {
 public:
     // Constructor with device ID, vendor ID and product ID
-    TemperatureSensor(uint8_t deviceId, uint32_t vendorId, uint32_t productId);
-    virtual ~TemperatureSensor() = default;
-    
+    IOLinkDevice(uint8_t deviceId, uint32_t vendorId, uint32_t productId);
+    virtual ~IOLinkDevice() = default;
+
+    // Device identification
+    uint8_t getDeviceId() const { return m_deviceId; }
+    uint32_t getVendorId() const { return m_vendorId; }
+    uint32_t getProductId() const { return m_productId; }
+
     // Device capabilities
-    bool supportsOperationMode(OperationMode mode) const override;
-    uint8_t getMinCycleTime() const override;
-    
+    virtual bool supportsOperationMode(OperationMode mode) const;
+    virtual uint8_t getMinCycleTime() const;
+
     // Process data handling
-    ErrorCode readProcessData(std::vector<uint8_t>& data) override;
-    ErrorCode writeProcessData(const std::vector<uint8_t>& data) override;
-    
+    virtual ErrorCode readProcessData(std::vector<uint8_t>& data);
+    virtual ErrorCode writeProcessData(const std::vector<uint8_t>& data);
+
     // Parameter access
-    ErrorCode readParameter(uint16_t index, uint8_t subindex, std::vector<uint8_t>& data) override;
-    ErrorCode writeParameter(uint16_t index, uint8_t subindex, const std::vector<uint8_t>& data) override;
-    
-    // Temperature-specific methods
-    float getTemperatureCelsius() const;
-    float getTemperatureFahrenheit() const;
-    
-    // Alarm thresholds
-    ErrorCode setTemperatureThresholds(float lowAlarm, float highAlarm);
-    ErrorCode getTemperatureThresholds(float& lowAlarm, float& highAlarm);
-    
-    // Unit configuration
-    enum class TemperatureUnit {
-        CELSIUS,
-        FAHRENHEIT,
-        KELVIN
+    virtual ErrorCode readParameter(uint16_t index, uint8_t subindex, std::vector<uint8_t>& data);
+    virtual ErrorCode writeParameter(uint16_t index, uint8_t subindex, const std::vector<uint8_t>& data);
+
+    // Diagnostics
+    virtual ErrorCode readDiagnostic(std::vector<uint8_t>& data);
+
+protected:
+    uint8_t m_deviceId;     // Device ID
+    uint32_t m_vendorId;    // Vendor ID
+    uint32_t m_productId;   // Product ID
+};
+
+/**
+ * @class IOLinkMaster
+ * @brief IO-Link master
+ *
+ * The master handles port activation, device discovery and the
+ * exchange of process data, parameters and events with devices.
+ * Each port talks to its device through a Transport, so the same
+ * master runs on a ClearCore serial port or on a Linux gateway.
+ */
+class IOLinkMaster {
+public:
+    // Constructor with the transport of port 0 and the clock used for timeouts
+    IOLinkMaster(Transport& transport, Clock& clock);
+
+#if defined(IOLINK_PLATFORM_CLEARCORE)
+    // Constructor with the ClearCore serial port used for IO-Link communication
+    explicit IOLinkMaster(SerialDriver& serialPort);
+#endif
+
+    ~IOLinkMaster() = default;
+
+    // Add a port with its own transport (returns the port number)
+    uint8_t addPort(Transport& transport);
+    size_t getPortCount() const { return m_ports.size(); }
+
+    // Clock used for timeouts
+    Clock& getClock() const { return *m_clock; }
+
+    // Timeout argument that derives the timeout from the wire timing of
+    // the exchange (see responseDeadline())
+    static constexpr uint32_t AUTO_TIMEOUT = 0;
+
+    static constexpr uint32_t DEFAULT_RESPONSE_MARGIN_US = 2000;    // Default allowance beyond the wire time
+
+    // Transport configuration (all ports); also selects the wire timing
+    void configure(uint32_t baudRate);
+    uint32_t getBaudRate() const { return m_timing.getBaudRate(); }
+    const WireTiming& getTiming() const { return m_timing; }
+
+    // Deadline for the reply to a request, derived from the time both
+    // frames take on the wire at the configured baud rate (COM1 before
+    // configure()) plus the response margin for host latency
+    Deadline responseDeadline(size_t requestLength, size_t responseLength);
+    void setResponseMargin(uint32_t marginUs) { m_responseMarginUs = marginUs; }
+
+    // Cycle period of an exchange on a port in nanoseconds: its wire time
+    // plus the response margin, but no shorter than the device's minimum
+    // cycle time (see CycleScheduler)
+    uint64_t getCycleTime(uint8_t port, size_t requestLength, size_t responseLength) const;
+
+    // Transmit queueing: when enabled, outgoing frames are collected per
+    // port and sent with one bulk write by flush() (receive calls flush
+    // their port first, so a request is never left waiting in the queue)
+    void setTransmitQueue(bool enable);
+    void flush();
+
+    // Receive waiting: poll the transport for up to spinUs before blocking
+    // in Transport::waitReadable() (0 = block right away)
+    void setReceiveSpin(uint32_t spinUs) { m_receiveSpinUs = spinUs; }
+
+    // Wait until data is received on a port or the deadline expires (for
+    // event loops that poll several ports without blocking, see Executor)
+    void waitForData(uint8_t port, const Deadline& deadline);
+
+    // Select the framing used on the wire (M-sequence type for Framing::M_SEQUENCE);
+    // a config beyond the M-sequence limits is rejected with INVALID_PARAMETER
+    ErrorCode setFraming(Framing framing, const MSequenceConfig& config = MSEQ_TYPE_0);
+    Framing getFraming() const { return m_framing; }
+
+    // Port control
+    ErrorCode activatePort(uint8_t port, OperationMode mode);
+    ErrorCode deactivatePort(uint8_t port);
+
+    // Device management
+    ErrorCode scanForDevices();
+    std::shared_ptr<IOLinkDevice> getDevice(uint8_t port);
+
+    // Message exchange. Sending a request discards the received frames of
+    // its type that nobody has read (late replies to earlier requests),
+    // so the next receive of that type returns the new reply.
+    ErrorCode sendMessage(uint8_t port, MessageType type, const std::vector<uint8_t>& data);
+    ErrorCode sendMessage(uint8_t port, MessageType type, const uint8_t* data, size_t length);
+    ErrorCode receiveMessage(uint8_t port, MessageType type, std::vector<uint8_t>& data, uint32_t timeout = 100);
+
+    // Zero-copy receive: the frame references the receive buffer and
+    // stays valid until the next receive or event processing call.
+    // With AUTO_TIMEOUT the reply to the last frame sent on the port is
+    // awaited for its wire time, counted from the moment that frame was
+    // written; the deadline grows to the frame's full length once its
+    // length byte has been received.
+    ErrorCode receiveMessage(uint8_t port, MessageType type, FrameView& frame, uint32_t timeout = 100);
+    ErrorCode receiveMessage(uint8_t port, MessageType type, FrameView& frame, const Deadline& deadline);
+    ErrorCode readProcessData(uint8_t port, FrameView& frame, uint32_t timeout = AUTO_TIMEOUT);
+    ErrorCode writeProcessData(uint8_t port, const uint8_t* data, size_t length);
+
+    // Update part of the last written process data and resend it
+    // (only the given bytes are rewritten, the checksum is patched)
+    ErrorCode patchProcessData(uint8_t port, size_t offset, const uint8_t* data, size_t length);
+
+    // Segmented (ISDU) parameter access that interleaves with cyclic data:
+    // start a transfer, then call serviceParameter() once per cycle while
+    // isParameterBusy(); each call exchanges one segment with the device
+    ErrorCode startParameterRead(uint8_t port, uint16_t index, uint8_t subindex);
+    ErrorCode startParameterWrite(uint8_t port, uint16_t index, uint8_t subindex, const uint8_t* data, size_t length);
+    ErrorCode serviceParameter(uint8_t port, uint32_t timeout = AUTO_TIMEOUT);
+    bool isParameterBusy(uint8_t port) const;
+
+    // Non-blocking serviceParameter() for event loops: each call either
+    // sends the next segment or takes the device reply if it has arrived
+    // (returns NONE while the transfer progresses, TIMEOUT when a reply
+    // is overdue and the segment will be repeated)
+    ErrorCode pollParameter(uint8_t port);
+
+    // Result of the last transfer; read data stays valid until the next transfer on the port
+    ErrorCode getParameterResult(uint8_t port, const uint8_t*& data, size_t& length) const;
+
+    // M-sequence exchange: send one master message and wait for the device reply
+    // (the reply references an internal buffer valid until the next exchange)
+    ErrorCode exchangeMSequence(uint8_t port, const MasterMessage& request, DeviceMessage& response, uint32_t timeout = AUTO_TIMEOUT);
+
+    // Event handling: events go to the subscribers of the event bus; the
+    // event callback is a subscriber to all events (registering another
+    // callback replaces it, nullptr removes it)
+    void registerEventCallback(EventCallback callback);
+    EventBus& getEventBus() { return m_eventBus; }
+    void processEvents();
+
+    // Frames of one type received while waiting for another type are
+    // queued per port and type until their reader takes them; this
+    // counts the frames dropped because such a queue was full
+    uint32_t getDroppedFrames(uint8_t port) const;
+
+    // Event-driven operation: decode everything received on a port without
+    // waiting and publish events on the event bus and pass all other
+    // frames to the frame callback. Call it when the port's transport
+    // becomes readable (see EpollReactor::addPort()).
+    void registerFrameCallback(FrameCallback callback);
+    ErrorCode servicePort(uint8_t port);
+
+    // Read and drop everything received on a port, including a partial frame
+    void discardInput(uint8_t port);
+
+private:
+    // Per-port state
+    struct PortState {
+        Transport* transport;           // Transport to the device
+        FrameDecoder decoder;           // Receive frame decoder (keeps state across reads)
+        FrameTemplate outputFrame;      // Cached process data output frame
+        IsduTransfer isdu;              // Segmented parameter transfer
+        Deadline isduDeadline;          // End of the time allowed for the parameter transfer
+        bool isduSegmentSent;           // pollParameter() awaits the reply to a segment
+        Deadline isduSegmentDeadline;   // Reply deadline of that segment
+        uint8_t txBuffer[2 * MAX_FRAME_LENGTH]; // Queued outgoing frames
+        size_t txLength;                // Number of queued bytes
+        size_t lastTxLength;            // Bytes of the last write (the request being answered)
+        uint64_t lastTxTime;            // Clock time the last write was issued (ns)
+        uint32_t rxCount;               // Bytes received (wraps)
+        FrameQueue rxQueues[MESSAGE_TYPE_COUNT]; // Received frames waiting for their reader (indexed by MessageType)
     };
-    
-    ErrorCode setTemperatureUnit(TemperatureUnit unit);
-    TemperatureUnit getTemperatureUnit() const;
-    
+
+    std::unique_ptr<Transport> m_ownedTransport;            // Transport created by the ClearCore constructor
+    std::unique_ptr<Clock> m_ownedClock;                    // Clock created by the ClearCore constructor
+    Clock* m_clock;                                         // Clock used for timeouts
+    std::vector<std::shared_ptr<IOLinkDevice>> m_devices;   // Connected devices (indexed by port)
+    EventBus m_eventBus;                                    // Event subscribers
+    uint32_t m_eventCallbackId;                             // Subscription of the event callback
+    FrameCallback m_frameCallback;                          // User frame callback (servicePort())
+    std::vector<PortState> m_ports;                         // Per-port state (indexed by port)
+    bool m_transmitQueue;                                   // Queue outgoing frames until flush()
+    uint32_t m_receiveSpinUs;                               // Spin phase before blocking for received data
+    WireTiming m_timing;                                    // Wire timing at the configured baud rate
+    uint32_t m_responseMarginUs;                            // Allowance for device response time and host latency
+    Framing m_framing;                                      // Framing used on the wire
+    MSequenceConfig m_mSequenceConfig;                      // M-sequence type for Framing::M_SEQUENCE
+    uint8_t m_mSequenceReply[MSEQ_MAX_LENGTH];              // Last device reply of an M-sequence
+
+    // Message framing
+    ErrorCode parseIOLinkMessage(const std::vector<uint8_t>& rawData, MessageType& type, std::vector<uint8_t>& payload);
+    ErrorCode parseIOLinkMessage(const uint8_t* rawData, size_t length, FrameView& frame);
+    std::vector<uint8_t> buildIOLinkMessage(MessageType type, const std::vector<uint8_t>& payload);
+    size_t buildIOLinkMessage(MessageType type, const uint8_t* payload, size_t length, uint8_t* buffer, size_t bufferSize);
+
+    template <size_t N>
+    size_t buildIOLinkMessage(MessageType type, const uint8_t* payload, size_t length, std::array<uint8_t, N>& buffer) {
+        return buildIOLinkMessage(type, payload, length, buffer.data(), N);
+    }
+
+    // Send (or queue) an encoded frame
+    void transmit(uint8_t port, const uint8_t* frame, size_t length);
+    void flushPort(uint8_t port);
+
+    // Read all pending bytes of a port into its decoder until a frame completes
+    bool pollFrame(uint8_t port);
+
+    // Take the next frame of a type: queued frames first, then newly
+    // decoded ones (frames of other types are queued on the way)
+    bool nextFrame(uint8_t port, MessageType type, FrameView& frame);
+
+    // Drop received frames of a request's type before the request is sent,
+    // so its reply is not taken from a stale one (events are kept)
+    void discardReplies(uint8_t port, MessageType type);
+
+    // Read a process data reply that arrives in one piece and decode it
+    // with the typed decoder (bytes of anything else go to the decoder)
+    bool readProcessDataFrame(uint8_t port, FrameView& frame);
+
+    // Decode an event frame and publish it on the event bus
+    void dispatchEvent(uint8_t port, const FrameView& frame);
+
+    // Receive a frame of the given type; with extend set, the deadline
+    // follows the last write on the port and the bytes expected on the wire
+    ErrorCode receiveFrame(uint8_t port, MessageType type, FrameView& frame, Deadline deadline, bool extend);
+};
+
+/**
+ * @class IOLinkIODD
+ * @brief Parser for IODD (IO Device Description) files
+ */
+class IOLinkIODD {
+public:
+    // Constructor with the path of the IODD file
+    explicit IOLinkIODD(const char* ioddFilePath);
+
+    // Parse the IODD file
+    bool parse();
+
+    // Device information
+    uint32_t getVendorId() const { return m_vendorId; }
+    uint32_t getProductId() const { return m_productId; }
+    const char* getProductName() const { return m_productName; }
+
+    // Process data layout
+    uint8_t getProcessDataInLength() const { return m_processDataInLength; }
+    uint8_t getProcessDataOutLength() const { return m_processDataOutLength; }
+
 private:
-    float m_currentTemperature;      // Current temperature reading
-    float m_lowAlarmThreshold;       // Low temperature alarm threshold
-    float m_highAlarmThreshold;      // High temperature alarm threshold
-    TemperatureUnit m_unit;          // Current temperature unit
-    
+    const char* m_ioddFilePath;         // Path of the IODD file
+    uint32_t m_vendorId;                // Vendor ID
+    uint32_t m_productId;               // Product ID
+    const char* m_productName;          // Product name
+    uint8_t m_processDataInLength;      // Process data input length (bytes)
+    uint8_t m_processDataOutLength;     // Process data output length (bytes)
+
     // Internal methods
-    float convertTemperature(float value, TemperatureUnit fromUnit, TemperatureUnit toUnit);
+    bool parseXML(const char* xmlContent);
 };
 
 } // namespace IOLink
 
-#endif // IOLINK_TEMPERATURE_SENSOR_H
+#endif // IOLINK_H
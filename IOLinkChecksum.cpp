@@ -0,0 +1,163 @@
+/**
+ * @file IOLinkChecksum.cpp
+ * @brief Checksum kernels used by the IO-Link framing
+ */
+
+#include "IOLinkChecksum.h"
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__SSE2__)
+#define IOLINK_CHECKSUM_SSE2 1
+#endif
+
+namespace IOLink {
+
+namespace {
+
+// Native word used by the portable kernel (64-bit on hosts, 32-bit on the MCU)
+typedef uintptr_t Word;
+
+// Below this length the setup cost of the wide kernels is not worth it
+constexpr size_t WIDE_THRESHOLD = 2 * sizeof(Word);
+
+// XOR all bytes of a word together
+inline uint8_t foldWord(Word value) {
+    for (size_t shift = sizeof(Word) * 4; shift >= 8; shift /= 2) {
+        value ^= value >> shift;
+    }
+    return static_cast<uint8_t>(value);
+}
+
+#if defined(IOLINK_CHECKSUM_SSE2)
+
+// Number of buffers folded side by side
+constexpr size_t LANES = 16;
+
+// Fold a buffer into a 16-byte accumulator (without reading past its end)
+inline __m128i foldVector(const uint8_t* data, size_t length) {
+    __m128i acc = _mm_setzero_si128();
+    for (; length >= 16; data += 16, length -= 16) {
+        acc = _mm_xor_si128(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+    }
+
+    // Fold the tail in scalar registers (copying it to a zero-padded
+    // vector stalls on the store-to-load forwarding of the copy)
+    if (length > 0) {
+        Word word = 0;
+        for (; length >= sizeof(Word); data += sizeof(Word), length -= sizeof(Word)) {
+            Word part;
+            memcpy(&part, data, sizeof(part));
+            word ^= part;
+        }
+        uint8_t tail = foldWord(word);
+        for (size_t i = 0; i < length; i++) {
+            tail ^= data[i];
+        }
+        acc = _mm_xor_si128(acc, _mm_cvtsi32_si128(tail));
+    }
+    return acc;
+}
+
+// Reduce pairs of accumulators: each step halves the vector count and
+// doubles the number of buffers sharing a vector
+template <typename Unpack>
+inline void reducePairs(__m128i* acc, size_t count, Unpack unpack) {
+    for (size_t i = 0; i < count / 2; i++) {
+        acc[i] = unpack(acc[2 * i], acc[2 * i + 1]);
+    }
+}
+
+// Checksums of 16 buffers; lane k of the result belongs to buffer k
+inline __m128i foldLanes(const uint8_t* const* data, const size_t* lengths) {
+    __m128i acc[LANES];
+    for (size_t k = 0; k < LANES; k++) {
+        acc[k] = foldVector(data[k], lengths[k]);
+    }
+
+    reducePairs(acc, 16, [](__m128i a, __m128i b) { return _mm_xor_si128(_mm_unpacklo_epi8(a, b), _mm_unpackhi_epi8(a, b)); });
+    reducePairs(acc, 8, [](__m128i a, __m128i b) { return _mm_xor_si128(_mm_unpacklo_epi16(a, b), _mm_unpackhi_epi16(a, b)); });
+    reducePairs(acc, 4, [](__m128i a, __m128i b) { return _mm_xor_si128(_mm_unpacklo_epi32(a, b), _mm_unpackhi_epi32(a, b)); });
+    reducePairs(acc, 2, [](__m128i a, __m128i b) { return _mm_xor_si128(_mm_unpacklo_epi64(a, b), _mm_unpackhi_epi64(a, b)); });
+    return acc[0];
+}
+
+#endif
+
+} // namespace
+
+uint8_t xorChecksum(const uint8_t* data, size_t length, uint8_t seed) {
+    uint8_t checksum = seed;
+
+    if (length >= WIDE_THRESHOLD) {
+        Word acc = 0;
+
+#if defined(__AVX2__)
+        if (length >= 32) {
+            __m256i vacc = _mm256_setzero_si256();
+            for (; length >= 32; data += 32, length -= 32) {
+                vacc = _mm256_xor_si256(vacc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)));
+            }
+            __m128i half = _mm_xor_si128(_mm256_castsi256_si128(vacc), _mm256_extracti128_si256(vacc, 1));
+            uint8_t lanes[16];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), half);
+            for (size_t i = 0; i < sizeof(lanes); i += sizeof(Word)) {
+                Word word;
+                memcpy(&word, lanes + i, sizeof(word));
+                acc ^= word;
+            }
+        }
+#elif defined(__SSE2__)
+        if (length >= 16) {
+            __m128i vacc = _mm_setzero_si128();
+            for (; length >= 16; data += 16, length -= 16) {
+                vacc = _mm_xor_si128(vacc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+            }
+            uint8_t lanes[16];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), vacc);
+            for (size_t i = 0; i < sizeof(lanes); i += sizeof(Word)) {
+                Word word;
+                memcpy(&word, lanes + i, sizeof(word));
+                acc ^= word;
+            }
+        }
+#endif
+
+        // Word-wide loop (memcpy keeps unaligned loads well-defined)
+        for (; length >= sizeof(Word); data += sizeof(Word), length -= sizeof(Word)) {
+            Word word;
+            memcpy(&word, data, sizeof(word));
+            acc ^= word;
+        }
+
+        checksum ^= foldWord(acc);
+    }
+
+    // Remaining bytes
+    for (size_t i = 0; i < length; i++) {
+        checksum ^= data[i];
+    }
+
+    return checksum;
+}
+
+void xorChecksums(const uint8_t* const* data, const size_t* lengths, size_t count, uint8_t* results) {
+    size_t i = 0;
+
+#if defined(IOLINK_CHECKSUM_SSE2)
+    for (; i + LANES <= count; i += LANES) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(results + i), foldLanes(data + i, lengths + i));
+    }
+#endif
+
+    for (; i < count; i++) {
+        results[i] = xorChecksum(data[i], lengths[i]);
+    }
+}
+
+} // namespace IOLink
@@ -0,0 +1,47 @@
+/**
+ * @file IOLinkChecksum.h
+ * @brief Checksum kernels used by the IO-Link framing
+ */
+
+#ifndef IOLINK_CHECKSUM_H
+#define IOLINK_CHECKSUM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace IOLink {
+
+/**
+ * @brief XOR of all bytes in a buffer
+ *
+ * Folds a machine word (or a 16/32 byte SSE2/AVX2 vector on host builds)
+ * per step instead of one byte at a time. Plain word-wide code is used
+ * where no vector unit is available (e.g. on the ClearCore MCU).
+ *
+ * @param data Bytes to fold
+ * @param length Number of bytes
+ * @param seed Initial checksum value
+ * @return seed XOR every byte of data
+ */
+uint8_t xorChecksum(const uint8_t* data, size_t length, uint8_t seed = 0);
+
+/**
+ * @brief XOR checksums of several buffers computed together
+ *
+ * Intended for verifying the frames of many ports gathered in one cycle.
+ * On SSE2 hosts, 16 buffers are processed side by side: each buffer is
+ * folded into its own 16-byte accumulator and the accumulators are then
+ * reduced together with a transposing unpack/XOR network, so lane k of
+ * the result holds the checksum of buffer k. Other targets fold each
+ * buffer with xorChecksum().
+ *
+ * @param data Buffers to fold
+ * @param lengths Length of each buffer
+ * @param count Number of buffers
+ * @param results Receives the XOR of every byte of each buffer
+ */
+void xorChecksums(const uint8_t* const* data, const size_t* lengths, size_t count, uint8_t* results);
+
+} // namespace IOLink
+
+#endif // IOLINK_CHECKSUM_H
@@ -0,0 +1,118 @@
+/**
+ * @file IOLinkClearCore.cpp
+ * @brief Transport and clock backends for the Teknic ClearCore
+ */
+
+#include "IOLinkClearCore.h"
+
+#if defined(IOLINK_PLATFORM_CLEARCORE)
+
+namespace IOLink {
+
+//-----------------------------------------------------------------------------
+// ClearCoreTransport Implementation
+//-----------------------------------------------------------------------------
+
+ClearCoreTransport::ClearCoreTransport(SerialDriver& serialPort)
+    : m_serialPort(serialPort) {
+}
+
+ErrorCode ClearCoreTransport::configure(uint32_t baudRate) {
+    // Configure the serial port for IO-Link communication
+    // IO-Link UART frame: 8 data bits, even parity, 1 stop bit
+    m_serialPort.Mode(SerialDriver::RS232);
+    m_serialPort.Speed(baudRate);
+    m_serialPort.CharSize(8);
+    m_serialPort.Parity(SerialDriver::PARITY_E);
+    m_serialPort.StopBits(1);
+    m_serialPort.FlowControl(SerialDriver::NoFlowControl);
+    
+    // Enable the serial port
+    m_serialPort.PortOpen();
+    
+    return ErrorCode::NONE;
+}
+
+size_t ClearCoreTransport::available() {
+    int32_t count = m_serialPort.BytesAvailable();
+    return count > 0 ? static_cast<size_t>(count) : 0;
+}
+
+int ClearCoreTransport::readByte() {
+    return m_serialPort.ReadChar();
+}
+
+size_t ClearCoreTransport::read(uint8_t* buffer, size_t length) {
+    // SerialDriver only reads one character at a time; drain its receive
+    // buffer from one loop (ReadChar() returns -1 once it is empty)
+    size_t count = 0;
+    while (count < length) {
+        int16_t byte = m_serialPort.ReadChar();
+        if (byte < 0) {
+            break;
+        }
+        buffer[count++] = static_cast<uint8_t>(byte);
+    }
+    return count;
+}
+
+bool ClearCoreTransport::writeByte(uint8_t byte) {
+    return m_serialPort.SendChar(byte);
+}
+
+size_t ClearCoreTransport::write(const uint8_t* data, size_t length) {
+    // SerialDriver has no binary block send (Send() stops at a zero byte),
+    // so feed its transmit buffer directly from one tight loop
+    size_t count = 0;
+    while (count < length && m_serialPort.SendChar(data[count])) {
+        count++;
+    }
+    return count;
+}
+
+ErrorCode ClearCoreTransport::waitReadable(uint32_t timeoutUs) {
+    // The receive interrupt fills the SerialDriver buffer; watch its fill
+    // level instead of sleeping a whole millisecond between polls
+    uint32_t start = Microseconds();
+    while (m_serialPort.BytesAvailable() <= 0) {
+        if ((Microseconds() - start) >= timeoutUs) {
+            return ErrorCode::TIMEOUT;
+        }
+    }
+    return ErrorCode::NONE;
+}
+
+//-----------------------------------------------------------------------------
+// ClearCoreClock Implementation
+//-----------------------------------------------------------------------------
+
+ClearCoreClock::ClearCoreClock()
+    : m_lastMicros(Microseconds())
+    , m_microsHigh(0) {
+}
+
+uint32_t ClearCoreClock::milliseconds() {
+    return Milliseconds();
+}
+
+uint64_t ClearCoreClock::microseconds() {
+    // Extend the 32-bit counter (wraps every 71 minutes) to 64 bits
+    uint32_t now = Microseconds();
+    if (now < m_lastMicros) {
+        m_microsHigh += 1ULL << 32;
+    }
+    m_lastMicros = now;
+    return m_microsHigh | now;
+}
+
+void ClearCoreClock::delayMilliseconds(uint32_t ms) {
+    delay(ms);
+}
+
+void ClearCoreClock::delayMicroseconds(uint32_t us) {
+    ::delayMicroseconds(us);
+}
+
+} // namespace IOLink
+
+#endif // IOLINK_PLATFORM_CLEARCORE
@@ -0,0 +1,60 @@
+/**
+ * @file IOLinkClearCore.h
+ * @brief Transport and clock backends for the Teknic ClearCore
+ */
+
+#ifndef IOLINK_CLEARCORE_H
+#define IOLINK_CLEARCORE_H
+
+#include "IOLinkConfig.h"
+
+#if defined(IOLINK_PLATFORM_CLEARCORE)
+
+#include "ClearCore.h"
+#include "IOLinkTransport.h"
+
+namespace IOLink {
+
+/**
+ * @class ClearCoreTransport
+ * @brief Transport over a ClearCore serial port
+ */
+class ClearCoreTransport : public Transport {
+public:
+    explicit ClearCoreTransport(SerialDriver& serialPort);
+
+    ErrorCode configure(uint32_t baudRate) override;
+    size_t available() override;
+    int readByte() override;
+    size_t read(uint8_t* buffer, size_t length) override;
+    bool writeByte(uint8_t byte) override;
+    size_t write(const uint8_t* data, size_t length) override;
+    ErrorCode waitReadable(uint32_t timeoutUs) override;
+
+private:
+    SerialDriver& m_serialPort;     // Serial port used for communication
+};
+
+/**
+ * @class ClearCoreClock
+ * @brief Clock based on the ClearCore system timer
+ */
+class ClearCoreClock : public Clock {
+public:
+    ClearCoreClock();
+
+    uint32_t milliseconds() override;
+    uint64_t microseconds() override;
+    void delayMilliseconds(uint32_t ms) override;
+    void delayMicroseconds(uint32_t us) override;
+
+private:
+    uint32_t m_lastMicros;      // Last 32-bit Microseconds() value
+    uint64_t m_microsHigh;      // Accumulated wrap-arounds of Microseconds()
+};
+
+} // namespace IOLink
+
+#endif // IOLINK_PLATFORM_CLEARCORE
+
+#endif // IOLINK_CLEARCORE_H
@@ -0,0 +1,37 @@
+/**
+ * @file IOLinkConfig.h
+ * @brief Build configuration of the IO-Link library
+ *
+ * The protocol core is platform independent. The platform selects which
+ * transport and clock backends are built:
+ *   - IOLINK_PLATFORM_CLEARCORE: Teknic ClearCore (SerialDriver, Milliseconds())
+ *   - IOLINK_PLATFORM_POSIX: Linux hosts (termios serial ports, monotonic clock)
+ *
+ * Define one of them to override the automatic selection.
+ *
+ * Optional features:
+ *   - IOLINK_USE_IO_URING: io_uring transport backend for Linux (IOLinkIoUring.h)
+ */
+
+#ifndef IOLINK_CONFIG_H
+#define IOLINK_CONFIG_H
+
+#if !defined(IOLINK_PLATFORM_CLEARCORE) && !defined(IOLINK_PLATFORM_POSIX)
+#if defined(__linux__)
+#define IOLINK_PLATFORM_POSIX 1
+#else
+#define IOLINK_PLATFORM_CLEARCORE 1
+#endif
+#endif
+
+// Alignment that keeps data written by different threads or interrupt
+// contexts on separate cache lines (the ClearCore MCU has no data cache)
+#if !defined(IOLINK_CACHE_LINE_SIZE)
+#if defined(IOLINK_PLATFORM_POSIX)
+#define IOLINK_CACHE_LINE_SIZE 64
+#else
+#define IOLINK_CACHE_LINE_SIZE 4
+#endif
+#endif
+
+#endif // IOLINK_CONFIG_H
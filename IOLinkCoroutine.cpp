@@ -0,0 +1,299 @@
+/**
+ * @file IOLinkCoroutine.cpp
+ * @brief C++20 coroutine API implementation
+ */
+
+#include "IOLinkCoroutine.h"
+
+#if defined(__cpp_impl_coroutine)
+
+#include <algorithm>
+
+namespace IOLink {
+
+//-----------------------------------------------------------------------------
+// AsyncOperation Implementation
+//-----------------------------------------------------------------------------
+
+constexpr int AsyncOperation::NO_PORT;
+
+AsyncOperation::AsyncOperation(Executor& executor, int port)
+    : m_executor(executor)
+    , m_port(port) {
+}
+
+bool AsyncOperation::await_suspend(std::coroutine_handle<> awaiting) {
+    // An operation that completes right away resumes the coroutine at once
+    if (!start()) {
+        return false;
+    }
+
+    m_awaiting = awaiting;
+    m_executor.m_operations.push_back(this);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// SleepOperation Implementation
+//-----------------------------------------------------------------------------
+
+SleepOperation::SleepOperation(Executor& executor, uint32_t us)
+    : AsyncOperation(executor, NO_PORT)
+    , m_us(us) {
+}
+
+bool SleepOperation::start() {
+    m_deadline = Deadline::fromMicroseconds(m_executor.getMaster().getClock(), m_us);
+    return !m_deadline.isExpired();
+}
+
+bool SleepOperation::poll() {
+    return m_deadline.isExpired();
+}
+
+//-----------------------------------------------------------------------------
+// ReceiveOperation Implementation
+//-----------------------------------------------------------------------------
+
+ReceiveOperation::ReceiveOperation(Executor& executor, uint8_t port, MessageType type, uint32_t timeout)
+    : AsyncOperation(executor, port)
+    , m_type(type)
+    , m_timeout(timeout)
+    , m_result{ErrorCode::TIMEOUT, {}} {
+}
+
+bool ReceiveOperation::start() {
+    m_deadline = Deadline::fromMilliseconds(m_executor.getMaster().getClock(), m_timeout);
+    return !poll();
+}
+
+bool ReceiveOperation::poll() {
+    // The next frames of the type are the replies of the transactions
+    // queued on the port; taking one would leave a transaction without it
+    if (m_executor.getTransactions().isPending(static_cast<uint8_t>(m_port), m_type)) {
+        m_result.result = ErrorCode::INVALID_PARAMETER;
+        return true;
+    }
+
+    IOLinkMaster& master = m_executor.getMaster();
+    FrameView frame;
+    ErrorCode result = master.receiveMessage(static_cast<uint8_t>(m_port), m_type, frame,
+                                             Deadline(master.getClock(), 0));
+    if (result == ErrorCode::TIMEOUT && !m_deadline.isExpired()) {
+        return false;
+    }
+
+    m_result.result = result;
+    if (result == ErrorCode::NONE) {
+        m_result.data.assign(frame.data, frame.data + frame.length);
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// TransactionOperation Implementation
+//-----------------------------------------------------------------------------
+
+TransactionOperation::TransactionOperation(Executor& executor, uint8_t port, MessageType type,
+                                           const uint8_t* data, size_t length, uint32_t timeout)
+    : AsyncOperation(executor, port)
+    , m_type(type)
+    , m_data(data)
+    , m_length(length)
+    , m_timeout(timeout)
+    , m_done(false)
+    , m_result{ErrorCode::TIMEOUT, {}} {
+}
+
+bool TransactionOperation::start() {
+    ErrorCode result = m_executor.getTransactions().submit(
+        static_cast<uint8_t>(m_port), m_type, m_data, m_length,
+        [this](uint8_t, ErrorCode status, const FrameView& frame) {
+            m_result.result = status;
+            m_result.data.assign(frame.data, frame.data + frame.length);
+            m_done = true;
+        },
+        m_timeout);
+    if (result != ErrorCode::NONE) {
+        m_result.result = result;
+        return false;
+    }
+
+    // A failed send completes the transaction inside submit()
+    if (m_done) {
+        return false;
+    }
+    m_deadline = m_executor.getTransactions().getDeadline(static_cast<uint8_t>(m_port));
+    return true;
+}
+
+bool TransactionOperation::poll() {
+    if (m_done) {
+        return true;
+    }
+
+    // The port is due when the transaction in flight expires: this one,
+    // or the one ahead of it until this request is sent
+    m_deadline = m_executor.getTransactions().getDeadline(static_cast<uint8_t>(m_port));
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+// ParameterOperation Implementation
+//-----------------------------------------------------------------------------
+
+ParameterOperation::ParameterOperation(Executor& executor, uint8_t port, uint16_t index, uint8_t subindex,
+                                       const uint8_t* data, size_t length, bool write)
+    : AsyncOperation(executor, port)
+    , m_index(index)
+    , m_subindex(subindex)
+    , m_data(data)
+    , m_length(length)
+    , m_write(write)
+    , m_result{ErrorCode::NONE, {}} {
+}
+
+bool ParameterOperation::start() {
+    IOLinkMaster& master = m_executor.getMaster();
+    uint8_t port = static_cast<uint8_t>(m_port);
+
+    // One transfer per port; a second one would abort the first
+    if (master.isParameterBusy(port)) {
+        m_result.result = ErrorCode::INVALID_PARAMETER;
+        return false;
+    }
+
+    ErrorCode result = m_write ? master.startParameterWrite(port, m_index, m_subindex, m_data, m_length)
+                               : master.startParameterRead(port, m_index, m_subindex);
+    if (result != ErrorCode::NONE) {
+        m_result.result = result;
+        return false;
+    }
+    return !poll();
+}
+
+bool ParameterOperation::poll() {
+    IOLinkMaster& master = m_executor.getMaster();
+    uint8_t port = static_cast<uint8_t>(m_port);
+
+    // Errors of single segments are retried until the transfer times out
+    master.pollParameter(port);
+    if (master.isParameterBusy(port)) {
+        return false;
+    }
+
+    const uint8_t* data;
+    size_t length;
+    m_result.result = master.getParameterResult(port, data, length);
+    if (m_result.result == ErrorCode::NONE) {
+        m_result.data.assign(data, data + length);
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Executor Implementation
+//-----------------------------------------------------------------------------
+
+Executor::Executor(IOLinkMaster& master)
+    : m_master(master)
+    , m_transactions(master)
+    , m_waitSliceUs(1000) {
+}
+
+Executor::~Executor() {
+    // The pending operations live in the frames destroyed here
+    m_operations.clear();
+    for (TaskHandle task : m_tasks) {
+        task.destroy();
+    }
+}
+
+void Executor::spawn(Task<void> task) {
+    TaskHandle handle = task.release();
+    if (!handle) {
+        return;
+    }
+
+    m_tasks.push_back(handle);
+    m_ready.push_back(handle);
+}
+
+bool Executor::runOnce(const Deadline& deadline) {
+    // Resume the coroutines whose operations completed
+    m_resuming.swap(m_ready);
+    for (std::coroutine_handle<> handle : m_resuming) {
+        handle.resume();
+    }
+    m_resuming.clear();
+
+    // Finished tasks are destroyed here (awaited tasks by their owner)
+    auto finished = std::remove_if(m_tasks.begin(), m_tasks.end(), [](TaskHandle task) {
+        if (task.done()) {
+            task.destroy();
+            return true;
+        }
+        return false;
+    });
+    m_tasks.erase(finished, m_tasks.end());
+    if (m_tasks.empty()) {
+        return false;
+    }
+
+    // Complete transactions and operations
+    m_transactions.poll();
+    for (size_t index = 0; index < m_operations.size();) {
+        AsyncOperation* operation = m_operations[index];
+        if (operation->poll()) {
+            m_ready.push_back(operation->m_awaiting);
+            m_operations[index] = m_operations.back();
+            m_operations.pop_back();
+        } else {
+            index++;
+        }
+    }
+
+    if (m_ready.empty() && !deadline.isExpired()) {
+        wait(deadline);
+    }
+    return true;
+}
+
+void Executor::run() {
+    while (runOnce()) {
+    }
+}
+
+void Executor::wait(const Deadline& deadline) {
+    Clock& clock = m_master.getClock();
+
+    // Wake up for the first operation deadline, after a slice at the latest
+    Deadline wait = Deadline::fromMicroseconds(clock, m_waitSliceUs);
+    if (deadline.getExpiry() < wait.getExpiry()) {
+        wait = deadline;
+    }
+
+    // Block on the port of the operation due first
+    int port = AsyncOperation::NO_PORT;
+    uint64_t portExpiry = Deadline::NEVER;
+    for (const AsyncOperation* operation : m_operations) {
+        if (operation->m_deadline.getExpiry() < wait.getExpiry()) {
+            wait = operation->m_deadline;
+        }
+        if (operation->m_port != AsyncOperation::NO_PORT &&
+            (port == AsyncOperation::NO_PORT || operation->m_deadline.getExpiry() < portExpiry)) {
+            port = operation->m_port;
+            portExpiry = operation->m_deadline.getExpiry();
+        }
+    }
+
+    if (port != AsyncOperation::NO_PORT) {
+        m_master.waitForData(static_cast<uint8_t>(port), wait);
+    } else {
+        clock.delayMicroseconds(wait.remainingMicroseconds());
+    }
+}
+
+} // namespace IOLink
+
+#endif // __cpp_impl_coroutine
@@ -0,0 +1,374 @@
+/**
+ * @file IOLinkCoroutine.h
+ * @brief C++20 coroutine API of the IO-Link master
+ *
+ * Awaitable variants of the master operations, driven by a
+ * single-threaded Executor, so startup sequences and parameter bursts on
+ * many ports can be written as straight-line code that still overlaps:
+ *
+ *     Task<void> configurePort(AsyncMaster& master, uint8_t port) {
+ *         AsyncResult name = co_await master.readParameter(port, 0x12, 0);
+ *         AsyncResult pd = co_await master.exchangeProcessData(port, output, 2);
+ *     }
+ *
+ * While a coroutine waits, the executor serves the other coroutines and
+ * polls the ports; when nothing is ready it blocks on the transport of
+ * the operation that is due first. Only built when the compiler supports
+ * coroutines (C++20).
+ */
+
+#ifndef IOLINK_COROUTINE_H
+#define IOLINK_COROUTINE_H
+
+#include "IOLinkConfig.h"
+
+#if defined(__cpp_impl_coroutine)
+
+#include "IOLink.h"
+#include "IOLinkTransaction.h"
+#include <stdint.h>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace IOLink {
+
+class Executor;
+
+/**
+ * @struct AsyncResult
+ * @brief Outcome of an asynchronous operation
+ */
+struct AsyncResult {
+    ErrorCode result;               // NONE on success
+    std::vector<uint8_t> data;      // Received payload or parameter data
+};
+
+template <typename T>
+class Task;
+
+/**
+ * @class TaskPromiseBase
+ * @brief Promise parts shared by all task types
+ *
+ * Tasks start suspended and run when awaited (or spawned). When a task
+ * finishes, the coroutine awaiting it resumes right away.
+ */
+class TaskPromiseBase {
+public:
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            std::coroutine_handle<> continuation = handle.promise().m_continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+    };
+
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    // The library reports errors with ErrorCode, never with exceptions
+    void unhandled_exception() noexcept { std::terminate(); }
+
+    void setContinuation(std::coroutine_handle<> continuation) { m_continuation = continuation; }
+
+private:
+    std::coroutine_handle<> m_continuation;     // Coroutine awaiting the task
+};
+
+// Promise of a task returning T
+template <typename T>
+class TaskPromise : public TaskPromiseBase {
+public:
+    Task<T> get_return_object();
+    void return_value(T value) { m_value.emplace(std::move(value)); }
+    T result() { return std::move(*m_value); }
+
+private:
+    std::optional<T> m_value;   // Returned value
+};
+
+// Promise of a task returning nothing
+template <>
+class TaskPromise<void> : public TaskPromiseBase {
+public:
+    Task<void> get_return_object();
+    void return_void() {}
+    void result() {}
+};
+
+/**
+ * @class Task
+ * @brief Coroutine returning T to the coroutine that awaits it
+ *
+ * Owns its coroutine. Await it from another task, or hand a Task<void>
+ * to Executor::spawn() to run it on its own.
+ */
+template <typename T>
+class Task {
+public:
+    using promise_type = TaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    explicit Task(Handle handle) : m_handle(handle) {}
+    Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+    ~Task() {
+        if (m_handle) {
+            m_handle.destroy();
+        }
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (m_handle) {
+                m_handle.destroy();
+            }
+            m_handle = std::exchange(other.m_handle, nullptr);
+        }
+        return *this;
+    }
+
+    bool isDone() const { return !m_handle || m_handle.done(); }
+
+    // Give up ownership of the coroutine (used by Executor::spawn())
+    Handle release() { return std::exchange(m_handle, nullptr); }
+
+    // Awaiting a task runs it until it finishes
+    bool await_ready() const { return isDone(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) {
+        m_handle.promise().setContinuation(awaiting);
+        return m_handle;
+    }
+    T await_resume() { return m_handle.promise().result(); }
+
+private:
+    Handle m_handle;    // Owned coroutine
+};
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+/**
+ * @class AsyncOperation
+ * @brief Awaitable operation completed by an Executor
+ *
+ * The operation starts when it is awaited. The executor then polls it
+ * each iteration and resumes the awaiting coroutine once it completes.
+ */
+class AsyncOperation {
+public:
+    virtual ~AsyncOperation() = default;
+
+    bool await_ready() const { return false; }
+    bool await_suspend(std::coroutine_handle<> awaiting);
+
+protected:
+    static constexpr int NO_PORT = -1;
+
+    // Operation on a port (NO_PORT if it does not wait for a port)
+    AsyncOperation(Executor& executor, int port);
+
+    // Begin the operation (returns false if it already completed)
+    virtual bool start() = 0;
+
+    // Check for completion without waiting
+    virtual bool poll() = 0;
+
+    Executor& m_executor;               // Executor completing the operation
+    int m_port;                         // Port whose data completes it (or NO_PORT)
+    Deadline m_deadline;                // Completion is due by then (for the executor's waits)
+
+private:
+    friend class Executor;
+
+    std::coroutine_handle<> m_awaiting; // Coroutine to resume on completion
+};
+
+// Pause a coroutine
+class SleepOperation : public AsyncOperation {
+public:
+    SleepOperation(Executor& executor, uint32_t us);
+    void await_resume() {}
+
+protected:
+    bool start() override;
+    bool poll() override;
+
+private:
+    uint32_t m_us;  // Pause duration
+};
+
+// Wait for the next frame of a type on a port (fails with
+// INVALID_PARAMETER while a transaction of that type is pending there)
+class ReceiveOperation : public AsyncOperation {
+public:
+    ReceiveOperation(Executor& executor, uint8_t port, MessageType type, uint32_t timeout);
+    AsyncResult await_resume() { return std::move(m_result); }
+
+protected:
+    bool start() override;
+    bool poll() override;
+
+private:
+    MessageType m_type;     // Awaited message type
+    uint32_t m_timeout;     // Timeout in ms
+    AsyncResult m_result;   // Outcome
+};
+
+// Send a request and wait for its reply (pipelined with other ports)
+class TransactionOperation : public AsyncOperation {
+public:
+    TransactionOperation(Executor& executor, uint8_t port, MessageType type, const uint8_t* data, size_t length, uint32_t timeout);
+    AsyncResult await_resume() { return std::move(m_result); }
+
+protected:
+    bool start() override;
+    bool poll() override;
+
+private:
+    MessageType m_type;     // Request and reply type
+    const uint8_t* m_data;  // Request payload (copied when the operation starts)
+    size_t m_length;        // Request payload length
+    uint32_t m_timeout;     // Timeout in ms (or AUTO_TIMEOUT)
+    bool m_done;            // Reply received or transaction failed
+    AsyncResult m_result;   // Outcome
+};
+
+// Segmented (ISDU) parameter read or write
+class ParameterOperation : public AsyncOperation {
+public:
+    ParameterOperation(Executor& executor, uint8_t port, uint16_t index, uint8_t subindex,
+                       const uint8_t* data, size_t length, bool write);
+    AsyncResult await_resume() { return std::move(m_result); }
+
+protected:
+    bool start() override;
+    bool poll() override;
+
+private:
+    uint16_t m_index;       // Parameter index
+    uint8_t m_subindex;     // Parameter subindex
+    const uint8_t* m_data;  // Data to write (copied when the operation starts)
+    size_t m_length;        // Length of the data to write
+    bool m_write;           // Write (true) or read (false)
+    AsyncResult m_result;   // Outcome (read data)
+};
+
+/**
+ * @class Executor
+ * @brief Single-threaded scheduler of the coroutines using one master
+ *
+ * Each iteration resumes the coroutines whose operations completed,
+ * polls the transactions and operations still pending and, when nothing
+ * is ready, waits for data on the port of the operation due first (for
+ * at most a slice, so other ports are served soon after their data
+ * arrives).
+ */
+class Executor {
+public:
+    explicit Executor(IOLinkMaster& master);
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    IOLinkMaster& getMaster() { return m_master; }
+    TransactionManager& getTransactions() { return m_transactions; }
+
+    // Run a task to completion alongside the others
+    void spawn(Task<void> task);
+    size_t getTaskCount() const { return m_tasks.size(); }
+
+    // One iteration, waiting no later than the deadline when nothing is
+    // ready (returns false once no task is left)
+    bool runOnce(const Deadline& deadline = Deadline());
+
+    // Run until every spawned task has finished
+    void run();
+
+    // Longest wait on one port per iteration (default 1 ms)
+    void setWaitSlice(uint32_t sliceUs) { m_waitSliceUs = sliceUs; }
+
+    // Awaitable pause
+    SleepOperation sleep(uint32_t us) { return SleepOperation(*this, us); }
+
+private:
+    friend class AsyncOperation;
+
+    using TaskHandle = std::coroutine_handle<TaskPromise<void>>;
+
+    IOLinkMaster& m_master;                         // Master used by the operations
+    TransactionManager m_transactions;              // Pipelined request/reply transactions
+    std::vector<TaskHandle> m_tasks;                // Spawned tasks
+    std::vector<AsyncOperation*> m_operations;      // Operations in progress
+    std::vector<std::coroutine_handle<>> m_ready;   // Coroutines to resume
+    std::vector<std::coroutine_handle<>> m_resuming; // Coroutines resumed in this iteration
+    uint32_t m_waitSliceUs;                         // Longest wait on one port
+
+    // Wait for data while nothing is ready
+    void wait(const Deadline& deadline);
+};
+
+/**
+ * @class AsyncMaster
+ * @brief Awaitable master operations
+ *
+ * Process data exchanges and other requests go through the executor's
+ * TransactionManager, so requests on different ports overlap. One
+ * parameter transfer may run per port at a time.
+ */
+class AsyncMaster {
+public:
+    explicit AsyncMaster(Executor& executor) : m_executor(executor) {}
+
+    // Send output process data and await the device's input process data
+    TransactionOperation exchangeProcessData(uint8_t port, const uint8_t* data, size_t length,
+                                             uint32_t timeout = IOLinkMaster::AUTO_TIMEOUT) {
+        return TransactionOperation(m_executor, port, MessageType::PROCESS_DATA, data, length, timeout);
+    }
+
+    // Await the next process data frame without sending a request (not
+    // while an exchange is pending on the port: its reply is that frame)
+    ReceiveOperation readProcessData(uint8_t port, uint32_t timeout = 100) {
+        return ReceiveOperation(m_executor, port, MessageType::PROCESS_DATA, timeout);
+    }
+
+    // Send a request of any type and await the reply of the same type
+    TransactionOperation request(uint8_t port, MessageType type, const uint8_t* data, size_t length,
+                                 uint32_t timeout = IOLinkMaster::AUTO_TIMEOUT) {
+        return TransactionOperation(m_executor, port, type, data, length, timeout);
+    }
+
+    // Segmented parameter access (see IOLinkMaster::startParameterRead())
+    ParameterOperation readParameter(uint8_t port, uint16_t index, uint8_t subindex) {
+        return ParameterOperation(m_executor, port, index, subindex, nullptr, 0, false);
+    }
+    ParameterOperation writeParameter(uint8_t port, uint16_t index, uint8_t subindex, const uint8_t* data, size_t length) {
+        return ParameterOperation(m_executor, port, index, subindex, data, length, true);
+    }
+
+    // Awaitable pause
+    SleepOperation sleep(uint32_t us) { return m_executor.sleep(us); }
+
+private:
+    Executor& m_executor;   // Executor running the operations
+};
+
+} // namespace IOLink
+
+#endif // __cpp_impl_coroutine
+
+#endif // IOLINK_COROUTINE_H
@@ -0,0 +1,287 @@
+/**
+ * @file IOLinkEpollReactor.cpp
+ * @brief epoll based event loop implementation
+ */
+
+#include "IOLinkEpollReactor.h"
+
+#if defined(IOLINK_PLATFORM_POSIX)
+
+#include "IOLink.h"
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace IOLink {
+
+namespace {
+
+// Convert microseconds to a timespec
+struct timespec toTimespec(uint32_t us) {
+    struct timespec ts;
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = static_cast<long>(us % 1000000) * 1000L;
+    return ts;
+}
+
+// Arm a timerfd (a zero delay would disarm it, so expire after 1 ns instead)
+bool armTimer(int fd, uint32_t delayUs, uint32_t periodUs) {
+    struct itimerspec spec;
+    spec.it_value = toTimespec(delayUs);
+    spec.it_interval = toTimespec(periodUs);
+    if (delayUs == 0) {
+        spec.it_value.tv_nsec = 1;
+    }
+    return timerfd_settime(fd, 0, &spec, nullptr) == 0;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+// EpollReactor Implementation
+//-----------------------------------------------------------------------------
+
+constexpr size_t EpollReactor::MAX_EVENTS;
+
+EpollReactor::EpollReactor()
+    : m_epollFd(epoll_create1(EPOLL_CLOEXEC))
+    , m_wakeFd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+    , m_running(false) {
+    if (m_epollFd >= 0 && m_wakeFd >= 0) {
+        // The wake eventfd is the only registration without an entry
+        struct epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;
+        epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &event);
+    }
+}
+
+EpollReactor::~EpollReactor() {
+    for (auto& registration : m_entries) {
+        if (registration.second->timer) {
+            close(registration.first);
+        }
+    }
+    if (m_wakeFd >= 0) {
+        close(m_wakeFd);
+    }
+    if (m_epollFd >= 0) {
+        close(m_epollFd);
+    }
+}
+
+ErrorCode EpollReactor::addFd(int fd, uint32_t events, ReadyHandler handler) {
+    if (fd < 0 || !handler) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+
+    std::unique_ptr<Entry> entry(new Entry());
+    entry->fd = fd;
+    entry->timer = false;
+    entry->active = true;
+    entry->ready = handler;
+    return add(std::move(entry), events);
+}
+
+ErrorCode EpollReactor::modifyFd(int fd, uint32_t events) {
+    auto registration = m_entries.find(fd);
+    if (registration == m_entries.end() || registration->second->timer) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+
+    struct epoll_event event = {};
+    event.events = events;
+    event.data.ptr = registration->second.get();
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_MOD, fd, &event) != 0) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+    return ErrorCode::NONE;
+}
+
+ErrorCode EpollReactor::removeFd(int fd) {
+    auto registration = m_entries.find(fd);
+    if (registration == m_entries.end() || registration->second->timer) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    return remove(fd);
+}
+
+ErrorCode EpollReactor::addPort(IOLinkMaster& master, uint8_t port, int fd, PortLostHandler lost) {
+    // servicePort() needs a scanned port and the simple framing
+    if (port >= master.getPortCount() || !master.getDevice(port)) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    if (master.getFraming() != Framing::SIMPLE) {
+        return ErrorCode::NOT_SUPPORTED;
+    }
+
+    IOLinkMaster* target = &master;
+    return addFd(fd, EPOLLIN, [this, target, port, fd, lost](uint32_t events) {
+        // A device that hung up stays ready while reads return nothing,
+        // so the fd is dropped (the handler is kept alive by the reactor
+        // until the batch is done)
+        if (events & (EPOLLHUP | EPOLLERR)) {
+            removeFd(fd);
+            if (lost) {
+                lost(port);
+            }
+            return;
+        }
+
+        // Input servicePort() refused to read (the master was rescanned
+        // or switched framing since) would keep the level-triggered fd
+        // ready forever, so it is dropped
+        if (target->servicePort(port) != ErrorCode::NONE) {
+            target->discardInput(port);
+        }
+    });
+}
+
+ErrorCode EpollReactor::addTimer(uint32_t delayUs, uint32_t periodUs, TimerHandler handler, int& timerId) {
+    if (!handler) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if (fd < 0) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+
+    std::unique_ptr<Entry> entry(new Entry());
+    entry->fd = fd;
+    entry->timer = true;
+    entry->active = true;
+    entry->expired = handler;
+
+    ErrorCode result = add(std::move(entry), EPOLLIN);
+    if (result != ErrorCode::NONE) {
+        close(fd);
+        return result;
+    }
+    if (!armTimer(fd, delayUs, periodUs)) {
+        cancelTimer(fd);
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+
+    // The timerfd doubles as the timer ID
+    timerId = fd;
+    return ErrorCode::NONE;
+}
+
+ErrorCode EpollReactor::restartTimer(int timerId, uint32_t delayUs, uint32_t periodUs) {
+    auto registration = m_entries.find(timerId);
+    if (registration == m_entries.end() || !registration->second->timer) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    return armTimer(timerId, delayUs, periodUs) ? ErrorCode::NONE : ErrorCode::COMMUNICATION_ERROR;
+}
+
+ErrorCode EpollReactor::cancelTimer(int timerId) {
+    auto registration = m_entries.find(timerId);
+    if (registration == m_entries.end() || !registration->second->timer) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+
+    ErrorCode result = remove(timerId);
+    close(timerId);
+    return result;
+}
+
+size_t EpollReactor::runOnce(int timeoutMs) {
+    if (m_epollFd < 0) {
+        return 0;
+    }
+
+    struct epoll_event events[MAX_EVENTS];
+    int count = epoll_wait(m_epollFd, events, MAX_EVENTS, timeoutMs);
+    if (count <= 0) {
+        return 0;
+    }
+
+    size_t dispatched = 0;
+    for (int i = 0; i < count; i++) {
+        Entry* entry = static_cast<Entry*>(events[i].data.ptr);
+        if (entry == nullptr) {
+            // stop() was called
+            uint64_t value;
+            ssize_t result = read(m_wakeFd, &value, sizeof(value));
+            (void)result;
+            m_running = false;
+            continue;
+        }
+
+        // Entries removed by an earlier handler of this batch are skipped
+        if (entry->active) {
+            dispatch(*entry, events[i].events);
+            dispatched++;
+        }
+    }
+
+    // Removed entries were kept alive until the batch was complete
+    m_retired.clear();
+    return dispatched;
+}
+
+void EpollReactor::run() {
+    m_running = true;
+    while (m_running) {
+        runOnce(-1);
+    }
+}
+
+void EpollReactor::stop() {
+    uint64_t value = 1;
+    ssize_t result = write(m_wakeFd, &value, sizeof(value));
+    (void)result;
+}
+
+ErrorCode EpollReactor::add(std::unique_ptr<Entry> entry, uint32_t events) {
+    if (m_epollFd < 0) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+    if (m_entries.count(entry->fd) != 0) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+
+    struct epoll_event event = {};
+    event.events = events;
+    event.data.ptr = entry.get();
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, entry->fd, &event) != 0) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+
+    int fd = entry->fd;
+    m_entries[fd] = std::move(entry);
+    return ErrorCode::NONE;
+}
+
+ErrorCode EpollReactor::remove(int fd) {
+    auto registration = m_entries.find(fd);
+    epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+
+    // The entry may be running or have an event pending in the current
+    // batch, so it is only destroyed after the batch
+    registration->second->active = false;
+    m_retired.push_back(std::move(registration->second));
+    m_entries.erase(registration);
+    return ErrorCode::NONE;
+}
+
+void EpollReactor::dispatch(Entry& entry, uint32_t events) {
+    if (!entry.timer) {
+        entry.ready(events);
+        return;
+    }
+
+    // Acknowledge the expiry (missed periods of a periodic timer are merged)
+    uint64_t expirations;
+    if (read(entry.fd, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+        entry.expired();
+    }
+}
+
+} // namespace IOLink
+
+#endif // IOLINK_PLATFORM_POSIX
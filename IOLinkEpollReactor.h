@@ -0,0 +1,116 @@
+/**
+ * @file IOLinkEpollReactor.h
+ * @brief epoll based event loop for Linux gateways with many ports
+ *
+ * Instead of polling every port in a delay loop, the reactor waits in
+ * epoll_wait() for any registered file descriptor to become ready and
+ * runs its handler. Timers and timeouts are timerfds in the same epoll
+ * set, so one thread serves all ports and timers with sub-millisecond
+ * wakeup latency and no idle CPU load.
+ *
+ * Serial ports are attached with addPort(): when the port's device is
+ * readable, the reactor calls IOLinkMaster::servicePort(), which decodes
+ * the received frames and passes them to the master's callbacks.
+ */
+
+#ifndef IOLINK_EPOLL_REACTOR_H
+#define IOLINK_EPOLL_REACTOR_H
+
+#include "IOLinkConfig.h"
+
+#if defined(IOLINK_PLATFORM_POSIX)
+
+#include "IOLinkTypes.h"
+#include <stdint.h>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace IOLink {
+
+class IOLinkMaster;
+
+// Handler invoked when a file descriptor is ready (events are EPOLLIN, EPOLLOUT, ...)
+using ReadyHandler = std::function<void(uint32_t events)>;
+
+// Handler invoked when a timer expires
+using TimerHandler = std::function<void()>;
+
+// Handler invoked when the device of a port hangs up or fails (e.g. a
+// USB serial adapter is unplugged)
+using PortLostHandler = std::function<void(uint8_t port)>;
+
+/**
+ * @class EpollReactor
+ * @brief Single-threaded dispatcher of file descriptor readiness and timers
+ *
+ * All methods except stop() must be called from the thread running the
+ * reactor (or before it starts). Handlers may add and remove file
+ * descriptors and timers, including their own.
+ */
+class EpollReactor {
+public:
+    static constexpr size_t MAX_EVENTS = 64;    // Events fetched per epoll_wait() call
+
+    EpollReactor();
+    ~EpollReactor();
+
+    EpollReactor(const EpollReactor&) = delete;
+    EpollReactor& operator=(const EpollReactor&) = delete;
+
+    // File descriptors (level-triggered)
+    ErrorCode addFd(int fd, uint32_t events, ReadyHandler handler);
+    ErrorCode modifyFd(int fd, uint32_t events);
+    ErrorCode removeFd(int fd);
+
+    // Drive a master port from the readiness of its device (fd is e.g.
+    // PosixSerialTransport::getFd() of the port's transport). The port must
+    // have been scanned and the master must use the simple framing. When
+    // the device hangs up or reports an error, the fd is removed and lost
+    // is called (reopen the transport and add the port again to resume).
+    ErrorCode addPort(IOLinkMaster& master, uint8_t port, int fd, PortLostHandler lost = PortLostHandler());
+
+    // Timers: first expiry after delayUs, then every periodUs (0 = one-shot)
+    // One-shot timers stay registered after expiry, so a timeout can be
+    // restarted for each request and is only released by cancelTimer()
+    ErrorCode addTimer(uint32_t delayUs, uint32_t periodUs, TimerHandler handler, int& timerId);
+    ErrorCode restartTimer(int timerId, uint32_t delayUs, uint32_t periodUs = 0);
+    ErrorCode cancelTimer(int timerId);
+
+    // Wait up to timeoutMs (-1 = forever) and dispatch ready handlers
+    // (returns the number of handlers run)
+    size_t runOnce(int timeoutMs = -1);
+
+    // Dispatch until stop() is called
+    void run();
+
+    // Make run() return (may be called from any thread or a handler)
+    void stop();
+
+private:
+    // Registered file descriptor or timer
+    struct Entry {
+        int fd;                 // Registered file descriptor
+        bool timer;             // fd is a timerfd owned by the reactor
+        bool active;            // Cleared when removed during dispatch
+        ReadyHandler ready;     // Handler of a file descriptor
+        TimerHandler expired;   // Handler of a timer
+    };
+
+    int m_epollFd;                                          // epoll instance
+    int m_wakeFd;                                           // eventfd used by stop()
+    bool m_running;                                         // run() keeps dispatching while set
+    std::unordered_map<int, std::unique_ptr<Entry>> m_entries;  // Registrations by fd
+    std::vector<std::unique_ptr<Entry>> m_retired;          // Entries removed during dispatch
+
+    ErrorCode add(std::unique_ptr<Entry> entry, uint32_t events);
+    ErrorCode remove(int fd);
+    void dispatch(Entry& entry, uint32_t events);
+};
+
+} // namespace IOLink
+
+#endif // IOLINK_PLATFORM_POSIX
+
+#endif // IOLINK_EPOLL_REACTOR_H
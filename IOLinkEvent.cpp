@@ -0,0 +1,201 @@
+/**
+ * @file IOLinkEvent.cpp
+ * @brief Device event decoding and event bus implementation
+ */
+
+#include "IOLinkEvent.h"
+#include <algorithm>
+#include <utility>
+
+namespace IOLink {
+
+bool decodeEvent(uint8_t port, const uint8_t* data, size_t length, Event& event) {
+    event.port = port;
+    event.data = data;
+    event.length = length;
+
+    if (length < 3) {
+        event.qualifier = 0;
+        event.code = 0;
+        event.severity = EventSeverity::UNKNOWN;
+        event.mode = EventMode::RESERVED;
+        return false;
+    }
+
+    event.qualifier = data[0];
+    event.code = static_cast<uint16_t>((data[1] << 8) | data[2]);
+    event.severity = static_cast<EventSeverity>((data[0] >> 4) & 0x03);
+    event.mode = static_cast<EventMode>((data[0] >> 6) & 0x03);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// EventBus Implementation
+//-----------------------------------------------------------------------------
+
+constexpr uint16_t EventFilter::ANY_PORT;
+constexpr uint8_t EventFilter::ALL_SEVERITIES;
+constexpr uint32_t EventBus::INVALID_SUBSCRIPTION;
+constexpr uint16_t EventBus::MAX_PORT;
+
+EventBus::EventBus()
+    : m_nextId(1)
+    , m_publishing(0)
+    , m_dirty(false) {
+}
+
+uint32_t EventBus::subscribe(const EventFilter& filter, EventHandler handler) {
+    // Route tables are built up to the highest port named, so a filter
+    // port must be a real one (0 to 255)
+    if (!handler || filter.firstCode > filter.lastCode ||
+        (filter.port != EventFilter::ANY_PORT && filter.port > MAX_PORT)) {
+        return INVALID_SUBSCRIPTION;
+    }
+
+    uint32_t id = m_nextId++;
+    if (m_nextId == INVALID_SUBSCRIPTION) {
+        m_nextId++;
+    }
+
+    m_subscribers.push_back(Subscriber{id, filter, std::move(handler), true});
+    changed();
+    return id;
+}
+
+bool EventBus::unsubscribe(uint32_t id) {
+    for (Subscriber& subscriber : m_subscribers) {
+        if (subscriber.id == id && subscriber.active) {
+            subscriber.active = false;
+            changed();
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t EventBus::getSubscriberCount() const {
+    size_t count = 0;
+    for (const Subscriber& subscriber : m_subscribers) {
+        if (subscriber.active) {
+            count++;
+        }
+    }
+    return count;
+}
+
+size_t EventBus::publish(const Event& event) {
+    const PortRoutes& portRoutes = (event.port < m_portRoutes.size()) ? m_portRoutes[event.port] : m_otherRoutes;
+    const std::vector<Route>& routes = portRoutes.routes[static_cast<uint8_t>(event.severity) & 0x03];
+    if (routes.empty()) {
+        return 0;
+    }
+
+    // Last route starting at or below the code (the first starts at 0)
+    auto route = std::upper_bound(routes.begin(), routes.end(), event.code,
+                                  [](uint16_t code, const Route& entry) { return code < entry.firstCode; });
+    --route;
+
+    // Handlers added while delivering are not part of the route, those
+    // removed are skipped; the tables change once delivery is over
+    size_t delivered = 0;
+    m_publishing++;
+    for (uint32_t index = route->begin; index < route->begin + route->count; index++) {
+        Subscriber& subscriber = m_subscribers[m_targets[index]];
+        if (subscriber.active) {
+            subscriber.handler(event);
+            delivered++;
+        }
+    }
+    m_publishing--;
+
+    if (m_publishing == 0 && m_dirty) {
+        rebuild();
+    }
+    return delivered;
+}
+
+void EventBus::changed() {
+    if (m_publishing > 0) {
+        m_dirty = true;
+    } else {
+        rebuild();
+    }
+}
+
+void EventBus::rebuild() {
+    m_dirty = false;
+    m_subscribers.erase(std::remove_if(m_subscribers.begin(), m_subscribers.end(),
+                                       [](const Subscriber& subscriber) { return !subscriber.active; }),
+                        m_subscribers.end());
+
+    // One table for each port named in a filter, one for all the others
+    size_t portCount = 0;
+    for (const Subscriber& subscriber : m_subscribers) {
+        if (subscriber.filter.port != EventFilter::ANY_PORT && subscriber.filter.port >= portCount) {
+            portCount = subscriber.filter.port + 1u;
+        }
+    }
+
+    m_targets.clear();
+    m_portRoutes.assign(portCount, PortRoutes());
+    for (size_t port = 0; port < portCount; port++) {
+        buildRoutes(static_cast<uint16_t>(port), m_portRoutes[port]);
+    }
+    buildRoutes(EventFilter::ANY_PORT, m_otherRoutes);
+}
+
+void EventBus::buildRoutes(uint16_t port, PortRoutes& portRoutes) {
+    for (size_t severity = 0; severity < EVENT_SEVERITY_COUNT; severity++) {
+        std::vector<Route>& routes = portRoutes.routes[severity];
+        routes.clear();
+
+        // Subscribers of this port and severity
+        std::vector<uint32_t> matching;
+        for (size_t index = 0; index < m_subscribers.size(); index++) {
+            const EventFilter& filter = m_subscribers[index].filter;
+            if ((filter.port == EventFilter::ANY_PORT || filter.port == port) &&
+                (filter.severities & (1u << severity))) {
+                matching.push_back(static_cast<uint32_t>(index));
+            }
+        }
+        if (matching.empty()) {
+            continue;
+        }
+
+        // The handler set only changes where a code range starts or ends
+        std::vector<uint32_t> bounds(1, 0);
+        for (uint32_t index : matching) {
+            const EventFilter& filter = m_subscribers[index].filter;
+            bounds.push_back(filter.firstCode);
+            bounds.push_back(filter.lastCode + 1u);
+        }
+        std::sort(bounds.begin(), bounds.end());
+        bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+        for (uint32_t code : bounds) {
+            if (code > 0xFFFF) {
+                break;
+            }
+
+            uint32_t begin = static_cast<uint32_t>(m_targets.size());
+            for (uint32_t index : matching) {
+                const EventFilter& filter = m_subscribers[index].filter;
+                if (filter.firstCode <= code && code <= filter.lastCode) {
+                    m_targets.push_back(index);
+                }
+            }
+            uint32_t count = static_cast<uint32_t>(m_targets.size()) - begin;
+
+            // Neighbouring ranges with the same handlers are merged
+            if (!routes.empty() && routes.back().count == count &&
+                std::equal(m_targets.begin() + routes.back().begin, m_targets.begin() + routes.back().begin + count,
+                           m_targets.begin() + begin)) {
+                m_targets.resize(begin);
+                continue;
+            }
+            routes.push_back(Route{static_cast<uint16_t>(code), begin, count});
+        }
+    }
+}
+
+} // namespace IOLink
@@ -0,0 +1,174 @@
+/**
+ * @file IOLinkEvent.h
+ * @brief Device events and the event bus delivering them to subscribers
+ *
+ * An event payload starts with the IO-Link EventQualifier and the 16-bit
+ * EventCode (IEC 61131-9):
+ *
+ *     [QUALIFIER] [CODE MSB] [CODE LSB] [...]
+ *
+ * QUALIFIER: MODE (bits 7-6), TYPE (bits 5-4, the severity), SOURCE
+ * (bit 3) and INSTANCE (bits 2-0).
+ */
+
+#ifndef IOLINK_EVENT_H
+#define IOLINK_EVENT_H
+
+#include "IOLinkConfig.h"
+#include "IOLinkTypes.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace IOLink {
+
+/**
+ * @enum EventSeverity
+ * @brief Event type coded in the EventQualifier
+ */
+enum class EventSeverity : uint8_t {
+    UNKNOWN = 0,        // Reserved type, or payload without a qualifier
+    NOTIFICATION = 1,   // Informational
+    WARNING = 2,        // Device still operating
+    ERROR = 3           // Device not operating correctly
+};
+
+constexpr size_t EVENT_SEVERITY_COUNT = 4;
+
+/**
+ * @enum EventMode
+ * @brief Event mode coded in the EventQualifier
+ */
+enum class EventMode : uint8_t {
+    RESERVED = 0,
+    SINGLE_SHOT = 1,    // Event without duration
+    DISAPPEARS = 2,     // Condition cleared
+    APPEARS = 3         // Condition raised
+};
+
+/**
+ * @struct Event
+ * @brief Decoded device event
+ *
+ * The payload references the receive buffer and is only valid during
+ * the delivery of the event.
+ */
+struct Event {
+    uint8_t port;               // Port the event was received on
+    uint8_t qualifier;          // EventQualifier (0 if the payload is too short)
+    uint16_t code;              // EventCode (0 if the payload is too short)
+    EventSeverity severity;     // From the qualifier
+    EventMode mode;             // From the qualifier
+    const uint8_t* data;        // Complete event payload
+    size_t length;              // Payload length
+};
+
+// Decode an event payload (returns false if it is too short to hold a
+// qualifier and code; the event is still filled in with UNKNOWN severity)
+bool decodeEvent(uint8_t port, const uint8_t* data, size_t length, Event& event);
+
+/**
+ * @struct EventFilter
+ * @brief Events a subscriber receives
+ *
+ * The default filter matches every event.
+ */
+struct EventFilter {
+    static constexpr uint16_t ANY_PORT = 0xFFFF;
+    static constexpr uint8_t ALL_SEVERITIES = 0x0F;
+
+    uint16_t port = ANY_PORT;           // Source port (0 to 255, or ANY_PORT)
+    uint16_t firstCode = 0x0000;        // Lowest EventCode
+    uint16_t lastCode = 0xFFFF;         // Highest EventCode
+    uint8_t severities = ALL_SEVERITIES; // Bit (1 << severity) set for each severity
+
+    // Mask bit of a severity
+    static constexpr uint8_t severityBit(EventSeverity severity) {
+        return static_cast<uint8_t>(1u << static_cast<uint8_t>(severity));
+    }
+};
+
+// Handler of a subscriber (the event is only valid during the call)
+using EventHandler = std::function<void(const Event& event)>;
+
+/**
+ * @class EventBus
+ * @brief Delivers events to the subscribers whose filter matches
+ *
+ * The subscriptions are compiled into routing tables, one per port named
+ * in a filter (plus one for all other ports) and severity. Each table
+ * splits the EventCode range at the filter boundaries, so publishing an
+ * event is a binary search that yields the matching handlers, in
+ * subscription order, without testing any filter.
+ *
+ * Handlers may subscribe and unsubscribe; the tables are rebuilt once
+ * the current event has been delivered. Not thread-safe: subscribe and
+ * publish from the thread running the protocol.
+ */
+class EventBus {
+public:
+    static constexpr uint32_t INVALID_SUBSCRIPTION = 0;
+    static constexpr uint16_t MAX_PORT = 255;   // Highest port number (ports are uint8_t)
+
+    EventBus();
+
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    // Add a subscriber (returns its subscription ID, or
+    // INVALID_SUBSCRIPTION for a missing handler, an empty code range or
+    // a port above 255 other than ANY_PORT)
+    uint32_t subscribe(const EventFilter& filter, EventHandler handler);
+
+    // Remove a subscriber (returns false if the ID is unknown)
+    bool unsubscribe(uint32_t id);
+
+    size_t getSubscriberCount() const;
+
+    // Deliver an event to the matching subscribers (returns their number)
+    size_t publish(const Event& event);
+
+private:
+    // Subscriber
+    struct Subscriber {
+        uint32_t id;                    // Subscription ID
+        EventFilter filter;             // Events delivered
+        EventHandler handler;           // Handler
+        bool active;                    // Not unsubscribed
+    };
+
+    // EventCode range starting at firstCode (up to the next route)
+    struct Route {
+        uint16_t firstCode;             // First code of the range
+        uint32_t begin;                 // First handler in m_targets
+        uint32_t count;                 // Number of handlers
+    };
+
+    // Routes of one port for each severity
+    struct PortRoutes {
+        std::vector<Route> routes[EVENT_SEVERITY_COUNT];
+    };
+
+    std::deque<Subscriber> m_subscribers;   // Subscribers in subscription order (stable while delivering)
+    std::vector<PortRoutes> m_portRoutes;   // Routes of the ports named in filters (indexed by port)
+    PortRoutes m_otherRoutes;               // Routes of all other ports (ANY_PORT subscribers)
+    std::vector<uint32_t> m_targets;        // Subscriber indexes referenced by the routes
+    uint32_t m_nextId;                      // Next subscription ID
+    uint32_t m_publishing;                  // Nesting depth of publish()
+    bool m_dirty;                           // Rebuild the routes after publishing
+
+    // Drop unsubscribed entries and compile the routing tables
+    void rebuild();
+
+    // Compile the routes of one port (ANY_PORT for the others)
+    void buildRoutes(uint16_t port, PortRoutes& routes);
+
+    // Rebuild now, or after the event being delivered
+    void changed();
+};
+
+} // namespace IOLink
+
+#endif // IOLINK_EVENT_H
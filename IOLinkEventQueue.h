@@ -0,0 +1,334 @@
+/**
+ * @file IOLinkEventQueue.h
+ * @brief Bounded lock-free event queue and threaded event dispatcher
+ *
+ * Event bus handlers run on the thread running the protocol, so a slow
+ * handler (one writing to storage, say) delays I/O on every port. An
+ * EventDispatcher subscribes to the bus, copies each event into a
+ * preallocated slot of an EventQueue and returns at once; handler
+ * threads take the events from the queue and call the application code.
+ * The protocol thread never blocks: when the queue is full, an event is
+ * dropped and counted.
+ */
+
+#ifndef IOLINK_EVENT_QUEUE_H
+#define IOLINK_EVENT_QUEUE_H
+
+#include "IOLinkConfig.h"
+#include "IOLinkTypes.h"
+#include "IOLinkFrame.h"
+#include "IOLinkEvent.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <utility>
+
+#if defined(IOLINK_PLATFORM_POSIX)
+#include <errno.h>
+#include <semaphore.h>
+#include <memory>
+#include <thread>
+#include <vector>
+#endif
+
+namespace IOLink {
+
+/**
+ * @enum OverflowPolicy
+ * @brief Event dropped when the queue is full
+ */
+enum class OverflowPolicy {
+    DROP_OLDEST,    // Discard the oldest queued event to store the new one
+    DROP_NEWEST     // Discard the new event
+};
+
+/**
+ * @class EventQueue
+ * @brief Bounded lock-free multi-producer event queue
+ *
+ * Capacity slots, each holding an event and its complete payload, are
+ * allocated with the queue. Every slot carries a sequence number (after
+ * D. Vyukov's bounded queue): producers claim the slot at the enqueue
+ * position with a single compare-and-swap, consumers the one at the
+ * dequeue position, and the sequence number tells either side whether
+ * the slot is free or filled. Neither side ever waits for the other.
+ *
+ * Any number of threads may push and pop concurrently.
+ */
+template <size_t Capacity>
+class EventQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Queue capacity must be a power of two");
+
+public:
+    explicit EventQueue(OverflowPolicy policy = OverflowPolicy::DROP_OLDEST)
+        : m_policy(policy)
+        , m_enqueuePos(0)
+        , m_dequeuePos(0)
+        , m_dropCount(0)
+        , m_highWater(0) {
+        for (size_t index = 0; index < Capacity; index++) {
+            m_slots[index].sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+    static constexpr size_t capacity() { return Capacity; }
+    OverflowPolicy getPolicy() const { return m_policy; }
+
+    // Copy an event and its payload into the queue (returns false if the
+    // event was dropped; with DROP_OLDEST an older event is dropped instead
+    // whenever possible)
+    bool push(const Event& event) {
+        for (int attempt = 0; attempt < 2; attempt++) {
+            if (tryPush(event)) {
+                return true;
+            }
+            if (m_policy == OverflowPolicy::DROP_NEWEST) {
+                break;
+            }
+
+            // Make room by discarding the oldest event
+            if (tryPop(nullptr, nullptr)) {
+                m_dropCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        m_dropCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Take the oldest event; its payload is copied to the buffer (at
+    // least MAX_PAYLOAD_LENGTH octets), which event.data then references
+    bool pop(Event& event, uint8_t* buffer) {
+        return tryPop(&event, buffer);
+    }
+
+    // Number of queued events (approximate while others push or pop)
+    size_t size() const {
+        size_t enqueuePos = m_enqueuePos.load(std::memory_order_relaxed);
+        size_t dequeuePos = m_dequeuePos.load(std::memory_order_relaxed);
+        return (enqueuePos > dequeuePos) ? enqueuePos - dequeuePos : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    // Events dropped because the queue was full
+    uint32_t getDropCount() const { return m_dropCount.load(std::memory_order_relaxed); }
+
+    // Largest number of events queued at once
+    size_t getHighWaterMark() const { return m_highWater.load(std::memory_order_relaxed); }
+
+    void resetStatistics() {
+        m_dropCount.store(0, std::memory_order_relaxed);
+        m_highWater.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    // Event slot (sequence == position: free for the producer at that
+    // position; sequence == position + 1: filled for the consumer)
+    struct alignas(IOLINK_CACHE_LINE_SIZE) Slot {
+        std::atomic<size_t> sequence;       // Slot state (see above)
+        Event event;                        // Event (data is set on pop)
+        uint8_t data[MAX_PAYLOAD_LENGTH];   // Event payload
+    };
+
+    const OverflowPolicy m_policy;                                  // Event dropped when full
+    alignas(IOLINK_CACHE_LINE_SIZE) std::atomic<size_t> m_enqueuePos;  // Next position to fill
+    alignas(IOLINK_CACHE_LINE_SIZE) std::atomic<size_t> m_dequeuePos;  // Next position to take
+    alignas(IOLINK_CACHE_LINE_SIZE) std::atomic<uint32_t> m_dropCount; // Dropped events
+    std::atomic<size_t> m_highWater;                                // Largest number of queued events
+    Slot m_slots[Capacity];                                         // Preallocated event slots
+
+    bool tryPush(const Event& event) {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &m_slots[pos & MASK];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (difference == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                // Slot still holds the event from one round before: full
+                return false;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        size_t length = (event.length < MAX_PAYLOAD_LENGTH) ? event.length : MAX_PAYLOAD_LENGTH;
+        slot->event = event;
+        slot->event.length = length;
+        if (length > 0) {
+            memcpy(slot->data, event.data, length);
+        }
+        slot->sequence.store(pos + 1, std::memory_order_release);
+
+        // Position pos is filled, so at least pos + 1 - dequeue events are queued
+        size_t queued = pos + 1 - m_dequeuePos.load(std::memory_order_relaxed);
+        if (queued <= Capacity) {
+            size_t highWater = m_highWater.load(std::memory_order_relaxed);
+            while (queued > highWater &&
+                   !m_highWater.compare_exchange_weak(highWater, queued, std::memory_order_relaxed)) {
+            }
+        }
+        return true;
+    }
+
+    // Take the oldest event (discard it if event is nullptr)
+    bool tryPop(Event* event, uint8_t* buffer) {
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &m_slots[pos & MASK];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (difference == 0) {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                // Slot not filled yet: empty
+                return false;
+            } else {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        if (event) {
+            *event = slot->event;
+            memcpy(buffer, slot->data, slot->event.length);
+            event->data = buffer;
+        }
+        slot->sequence.store(pos + Capacity, std::memory_order_release);
+        return true;
+    }
+};
+
+#if defined(IOLINK_PLATFORM_POSIX)
+
+/**
+ * @class EventDispatcher
+ * @brief Runs an event handler on its own threads
+ *
+ * Subscribes to an event bus with a filter; the subscription only queues
+ * the event, and threadCount handler threads call the handler. With more
+ * than one thread, events may be handled concurrently and out of order.
+ *
+ * Start and stop the dispatcher from the thread running the protocol
+ * (the event bus is not thread-safe). stop() lets the threads handle the
+ * events still queued.
+ */
+template <size_t Capacity = 64>
+class EventDispatcher {
+public:
+    EventDispatcher(EventBus& bus, const EventFilter& filter, EventHandler handler,
+                    size_t threadCount = 1, OverflowPolicy policy = OverflowPolicy::DROP_OLDEST)
+        : m_bus(bus)
+        , m_filter(filter)
+        , m_handler(std::move(handler))
+        , m_threadCount(threadCount > 0 ? threadCount : 1)
+        , m_queue(new EventQueue<Capacity>(policy))
+        , m_subscription(EventBus::INVALID_SUBSCRIPTION)
+        , m_running(false) {
+        sem_init(&m_available, 0, 0);
+    }
+
+    ~EventDispatcher() {
+        stop();
+        sem_destroy(&m_available);
+    }
+
+    EventDispatcher(const EventDispatcher&) = delete;
+    EventDispatcher& operator=(const EventDispatcher&) = delete;
+
+    ErrorCode start() {
+        if (!m_handler || m_running.exchange(true, std::memory_order_acq_rel)) {
+            return ErrorCode::INVALID_PARAMETER;
+        }
+
+        // Called on the protocol thread: copy the event and wake a handler
+        // thread (events queued before the threads run are counted by the
+        // semaphore)
+        m_subscription = m_bus.subscribe(m_filter, [this](const Event& event) {
+            if (m_queue->push(event)) {
+                sem_post(&m_available);
+            }
+        });
+        if (m_subscription == EventBus::INVALID_SUBSCRIPTION) {
+            // Filter rejected by the bus: nothing was started
+            m_running.store(false, std::memory_order_release);
+            return ErrorCode::INVALID_PARAMETER;
+        }
+
+        for (size_t index = 0; index < m_threadCount; index++) {
+            m_threads.emplace_back(&EventDispatcher::run, this);
+        }
+        return ErrorCode::NONE;
+    }
+
+    void stop() {
+        if (!m_running.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        m_bus.unsubscribe(m_subscription);
+        m_subscription = EventBus::INVALID_SUBSCRIPTION;
+        m_running.store(false, std::memory_order_release);
+        for (size_t index = 0; index < m_threads.size(); index++) {
+            sem_post(&m_available);
+        }
+        for (std::thread& thread : m_threads) {
+            thread.join();
+        }
+        m_threads.clear();
+    }
+
+    // Queue statistics
+    const EventQueue<Capacity>& getQueue() const { return *m_queue; }
+    uint32_t getDropCount() const { return m_queue->getDropCount(); }
+    size_t getHighWaterMark() const { return m_queue->getHighWaterMark(); }
+
+private:
+    EventBus& m_bus;                                // Bus delivering the events
+    EventFilter m_filter;                           // Events handled
+    EventHandler m_handler;                         // Application handler
+    size_t m_threadCount;                           // Number of handler threads
+    std::unique_ptr<EventQueue<Capacity>> m_queue;  // Events waiting for a handler thread
+    uint32_t m_subscription;                        // Subscription on the bus
+    sem_t m_available;                              // Posted once per queued event
+    std::atomic<bool> m_running;                    // Handler threads keep running while set
+    std::vector<std::thread> m_threads;             // Handler threads
+
+    // Handler thread
+    void run() {
+        uint8_t buffer[MAX_PAYLOAD_LENGTH];
+        while (true) {
+            while (sem_wait(&m_available) != 0 && errno == EINTR) {
+            }
+
+            // A wake-up may find several events (or none, when an older
+            // event was dropped to make room)
+            Event event;
+            while (m_queue->pop(event, buffer)) {
+                m_handler(event);
+            }
+            if (!m_running.load(std::memory_order_acquire)) {
+                break;
+            }
+        }
+    }
+};
+
+#endif // IOLINK_PLATFORM_POSIX
+
+} // namespace IOLink
+
+#endif // IOLINK_EVENT_QUEUE_H
@@ -0,0 +1,355 @@
+/**
+ * @file IOLinkFrame.cpp
+ * @brief IO-Link message framing implementation
+ */
+
+#include "IOLinkFrame.h"
+#include <string.h>
+
+namespace IOLink {
+
+//-----------------------------------------------------------------------------
+// Frame Encoding
+//-----------------------------------------------------------------------------
+
+size_t encodeFrame(MessageType type, const uint8_t* payload, size_t length, uint8_t* buffer, size_t bufferSize) {
+    if (!isValidMessageType(type)) {
+        return 0;
+    }
+    return encodeFrameValue(messageTypeValue(type), payload, length, buffer, bufferSize);
+}
+
+size_t encodeFrameValue(uint8_t typeValue, const uint8_t* payload, size_t length, uint8_t* buffer, size_t bufferSize) {
+    if (length > MAX_PAYLOAD_LENGTH || bufferSize < length + FRAME_OVERHEAD) {
+        return 0;
+    }
+
+    buffer[0] = FRAME_START_BYTE;
+    buffer[1] = typeValue;
+    buffer[2] = static_cast<uint8_t>(length);
+
+    // Copy payload and calculate checksum (simple XOR)
+    uint8_t* out = buffer + FRAME_HEADER_LENGTH;
+    memcpy(out, payload, length);
+    out[length] = xorChecksum(payload, length, buffer[0] ^ buffer[1] ^ buffer[2]);
+
+    return length + FRAME_OVERHEAD;
+}
+
+uint64_t verifyFrames(const uint8_t* const* frames, const size_t* lengths, size_t count) {
+    if (count > 64) {
+        count = 64;
+    }
+
+    uint8_t checksums[64];
+    xorChecksums(frames, lengths, count, checksums);
+
+    uint64_t good = 0;
+    MessageType type;
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t* frame = frames[i];
+        if (lengths[i] >= FRAME_OVERHEAD &&
+            frame[0] == FRAME_START_BYTE &&
+            decodeMessageType(frame[1], type) &&
+            frame[2] + FRAME_OVERHEAD == lengths[i] &&
+            checksums[i] == 0) {
+            good |= uint64_t(1) << i;
+        }
+    }
+    return good;
+}
+
+//-----------------------------------------------------------------------------
+// FrameTemplate Implementation
+//-----------------------------------------------------------------------------
+
+FrameTemplate::FrameTemplate()
+    : m_length(0)
+    , m_type(MessageType::PROCESS_DATA)
+    , m_valid(false) {
+}
+
+bool FrameTemplate::build(MessageType type, const uint8_t* payload, size_t length) {
+    m_valid = encodeFrame(type, payload, length, m_frame, sizeof(m_frame)) > 0;
+    m_type = type;
+    m_length = length;
+    return m_valid;
+}
+
+size_t FrameTemplate::update(const uint8_t* payload, size_t length) {
+    if (!m_valid || length != m_length) {
+        return 0;
+    }
+
+    size_t changed = 0;
+    const uint8_t* current = m_frame + FRAME_HEADER_LENGTH;
+    for (size_t i = 0; i < length; i++) {
+        if (current[i] != payload[i]) {
+            setPayloadByte(i, payload[i]);
+            changed++;
+        }
+    }
+    return changed;
+}
+
+bool FrameTemplate::patch(size_t offset, const uint8_t* data, size_t length) {
+    if (!m_valid || offset > m_length || length > m_length - offset) {
+        return false;
+    }
+
+    for (size_t i = 0; i < length; i++) {
+        setPayloadByte(offset + i, data[i]);
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// FrameParser Implementation
+//-----------------------------------------------------------------------------
+
+FrameParser::FrameParser(const uint8_t* data, size_t length) {
+    restart(data, length);
+}
+
+void FrameParser::restart(const uint8_t* data, size_t length) {
+    m_data = data;
+    m_start = 0;
+    m_pos = 0;
+    m_end = length;
+    m_state = State::HUNT;
+    m_length = 0;
+    m_checksum = 0;
+    m_type = MessageType::PROCESS_DATA;
+    m_frameStart = 0;
+    m_frameLength = 0;
+    m_frameType = MessageType::PROCESS_DATA;
+}
+
+bool FrameParser::next() {
+    while (m_pos < m_end) {
+        switch (m_state) {
+            case State::HUNT: {
+                const void* found = memchr(m_data + m_pos, FRAME_START_BYTE, m_end - m_pos);
+                if (!found) {
+                    // Nothing worth keeping
+                    m_start = m_pos = m_end;
+                    return false;
+                }
+                m_start = static_cast<const uint8_t*>(found) - m_data;
+                m_pos = m_start + 1;
+                m_checksum = FRAME_START_BYTE;
+                m_state = State::TYPE;
+                break;
+            }
+
+            case State::TYPE: {
+                uint8_t typeValue = m_data[m_pos++];
+                if (!decodeMessageType(typeValue, m_type)) {
+                    discardCandidate();
+                    break;
+                }
+                m_checksum ^= typeValue;
+                m_state = State::LENGTH;
+                break;
+            }
+
+            case State::LENGTH:
+                m_length = m_data[m_pos++];
+                m_checksum ^= m_length;
+                m_state = (m_length > 0) ? State::PAYLOAD : State::CHECKSUM;
+                break;
+
+            case State::PAYLOAD: {
+                // Consume as much of the payload as has arrived
+                size_t payloadEnd = m_start + FRAME_HEADER_LENGTH + m_length;
+                size_t stop = (payloadEnd < m_end) ? payloadEnd : m_end;
+                m_checksum = xorChecksum(m_data + m_pos, stop - m_pos, m_checksum);
+                m_pos = stop;
+                if (m_pos == payloadEnd) {
+                    m_state = State::CHECKSUM;
+                }
+                break;
+            }
+
+            case State::CHECKSUM:
+                if (m_data[m_pos++] != m_checksum) {
+                    discardCandidate();
+                    break;
+                }
+
+                // Complete frame
+                m_frameStart = m_start;
+                m_frameLength = m_length;
+                m_frameType = m_type;
+                m_start = m_pos;
+                m_state = State::HUNT;
+                return true;
+        }
+    }
+
+    return false;
+}
+
+size_t FrameParser::missing() const {
+    size_t frameLength = FRAME_OVERHEAD;
+    if (m_state == State::PAYLOAD || m_state == State::CHECKSUM) {
+        frameLength += m_length;
+    } else if (m_state == State::HUNT) {
+        return FRAME_OVERHEAD;
+    }
+
+    size_t received = m_end - m_start;
+    return (frameLength > received) ? frameLength - received : 0;
+}
+
+void FrameParser::discardCandidate() {
+    // The start byte was noise (or a corrupted frame); a real frame may
+    // begin anywhere after it, including inside the rejected candidate
+    m_pos = m_start + 1;
+    m_start = m_pos;
+    m_state = State::HUNT;
+}
+
+//-----------------------------------------------------------------------------
+// FrameDecoder Implementation
+//-----------------------------------------------------------------------------
+
+constexpr size_t FrameDecoder::BUFFER_SIZE;
+
+FrameDecoder::FrameDecoder()
+    : FrameParser(nullptr, 0) {
+    reset();
+}
+
+FrameDecoder::FrameDecoder(const FrameDecoder& other)
+    : FrameParser(other) {
+    memcpy(m_buffer, other.m_buffer, other.m_end);
+    m_data = m_buffer;
+}
+
+FrameDecoder& FrameDecoder::operator=(const FrameDecoder& other) {
+    if (this != &other) {
+        FrameParser::operator=(other);
+        memcpy(m_buffer, other.m_buffer, other.m_end);
+        m_data = m_buffer;
+    }
+    return *this;
+}
+
+void FrameDecoder::reset() {
+    restart(m_buffer, 0);
+}
+
+size_t FrameDecoder::write(const uint8_t* data, size_t length) {
+    if (m_end + length > BUFFER_SIZE) {
+        compact();
+    }
+
+    size_t count = BUFFER_SIZE - m_end;
+    if (count > length) {
+        count = length;
+    }
+
+    memcpy(m_buffer + m_end, data, count);
+    m_end += count;
+    return count;
+}
+
+bool FrameDecoder::write(uint8_t byte) {
+    return write(&byte, 1) == 1;
+}
+
+uint8_t* FrameDecoder::writeBuffer(size_t& space) {
+    // Keep room for at least one complete frame behind the undecoded bytes
+    if (BUFFER_SIZE - m_end < MAX_FRAME_LENGTH) {
+        compact();
+    }
+
+    space = BUFFER_SIZE - m_end;
+    return m_buffer + m_end;
+}
+
+void FrameDecoder::commit(size_t count) {
+    if (count > BUFFER_SIZE - m_end) {
+        count = BUFFER_SIZE - m_end;
+    }
+    m_end += count;
+}
+
+void FrameDecoder::compact() {
+    if (m_start == 0) {
+        return;
+    }
+
+    size_t count = m_end - m_start;
+    memmove(m_buffer, m_buffer + m_start, count);
+    m_pos -= m_start;
+    m_end = count;
+    m_start = 0;
+}
+
+//-----------------------------------------------------------------------------
+// FrameQueue Implementation
+//-----------------------------------------------------------------------------
+
+constexpr size_t FrameQueue::BUFFER_SIZE;
+
+FrameQueue::FrameQueue()
+    : m_head(0)
+    , m_tail(0)
+    , m_count(0)
+    , m_dropped(0) {
+}
+
+void FrameQueue::clear() {
+    m_head = 0;
+    m_tail = 0;
+    m_count = 0;
+}
+
+bool FrameQueue::push(const uint8_t* payload, size_t length) {
+    if (length > MAX_PAYLOAD_LENGTH) {
+        return false;
+    }
+    size_t record = 1 + length;
+
+    // Drop the oldest frames until the record fits
+    bool kept = true;
+    while (m_count > 0 && (m_tail - m_head) + record > BUFFER_SIZE) {
+        m_head += 1 + m_buffer[m_head];
+        m_count--;
+        m_dropped++;
+        kept = false;
+    }
+    if (m_count == 0) {
+        m_head = 0;
+        m_tail = 0;
+    }
+
+    // Move the queued records to the front when the end is reached
+    if (m_tail + record > BUFFER_SIZE) {
+        memmove(m_buffer, m_buffer + m_head, m_tail - m_head);
+        m_tail -= m_head;
+        m_head = 0;
+    }
+
+    m_buffer[m_tail] = static_cast<uint8_t>(length);
+    memcpy(m_buffer + m_tail + 1, payload, length);
+    m_tail += record;
+    m_count++;
+    return kept;
+}
+
+bool FrameQueue::pop(const uint8_t*& payload, size_t& length) {
+    if (m_count == 0) {
+        return false;
+    }
+
+    length = m_buffer[m_head];
+    payload = m_buffer + m_head + 1;
+    m_head += 1 + length;
+    m_count--;
+    return true;
+}
+
+} // namespace IOLink
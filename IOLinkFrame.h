@@ -0,0 +1,391 @@
+/**
+ * @file IOLinkFrame.h
+ * @brief IO-Link message framing
+ *
+ * Messages exchanged with devices use the format
+ * [START_BYTE] [TYPE] [LENGTH] [PAYLOAD] [CHECKSUM], where the checksum
+ * is the XOR of all preceding bytes of the frame.
+ */
+
+#ifndef IOLINK_FRAME_H
+#define IOLINK_FRAME_H
+
+#include "IOLinkTypes.h"
+#include "IOLinkChecksum.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <array>
+
+namespace IOLink {
+
+// Frame layout
+constexpr uint8_t FRAME_START_BYTE = 0xA5;      // First byte of every frame
+constexpr size_t FRAME_HEADER_LENGTH = 3;       // Start byte, type and length
+constexpr size_t FRAME_OVERHEAD = 4;            // Header plus checksum
+constexpr size_t MAX_PAYLOAD_LENGTH = 255;      // Limited by the 8-bit length field
+constexpr size_t MAX_FRAME_LENGTH = MAX_PAYLOAD_LENGTH + FRAME_OVERHEAD;
+
+// Number of message types
+constexpr size_t MESSAGE_TYPE_COUNT = 4;
+
+// Wire value of each message type (indexed by MessageType)
+constexpr uint8_t MESSAGE_TYPE_VALUES[MESSAGE_TYPE_COUNT] = {
+    0x01,   // PROCESS_DATA
+    0x02,   // PARAMETER
+    0x03,   // DIAGNOSTIC
+    0x04    // EVENT
+};
+
+// Build the wire value to message type table (-1 for invalid values)
+constexpr std::array<int8_t, 256> makeMessageTypeTable() {
+    std::array<int8_t, 256> table{};
+    for (size_t i = 0; i < table.size(); i++) {
+        table[i] = -1;
+    }
+    for (size_t type = 0; type < MESSAGE_TYPE_COUNT; type++) {
+        table[MESSAGE_TYPE_VALUES[type]] = static_cast<int8_t>(type);
+    }
+    return table;
+}
+
+// Message type of each wire value
+constexpr std::array<int8_t, 256> MESSAGE_TYPE_TABLE = makeMessageTypeTable();
+
+constexpr bool isValidMessageType(MessageType type) {
+    return static_cast<size_t>(type) < MESSAGE_TYPE_COUNT;
+}
+
+// Wire value of a message type (0 for an invalid type)
+constexpr uint8_t messageTypeValue(MessageType type) {
+    return isValidMessageType(type) ? MESSAGE_TYPE_VALUES[static_cast<size_t>(type)] : 0;
+}
+
+// Message type of a wire value
+inline bool decodeMessageType(uint8_t typeValue, MessageType& type) {
+    int8_t index = MESSAGE_TYPE_TABLE[typeValue];
+    if (index < 0) {
+        return false;
+    }
+    type = static_cast<MessageType>(index);
+    return true;
+}
+
+/**
+ * @struct MessageTraits
+ * @brief Compile-time properties of a message type
+ *
+ * Instantiating the traits of an invalid type fails to compile, so the
+ * per-type codecs below cannot be used with one.
+ */
+template <MessageType T>
+struct MessageTraits {
+    static_assert(isValidMessageType(T), "Invalid message type");
+    static constexpr uint8_t VALUE = MESSAGE_TYPE_VALUES[static_cast<size_t>(T)];
+};
+
+/**
+ * @brief Encode a frame into a caller-supplied buffer
+ *
+ * @param type Message type
+ * @param payload Payload bytes
+ * @param length Payload length (at most MAX_PAYLOAD_LENGTH)
+ * @param buffer Output buffer
+ * @param bufferSize Size of the output buffer
+ * @return Frame length in bytes, or 0 if the type is invalid, the payload
+ *         is too long or the buffer too small
+ */
+size_t encodeFrame(MessageType type, const uint8_t* payload, size_t length, uint8_t* buffer, size_t bufferSize);
+
+// Encode a frame with an already mapped wire type value
+size_t encodeFrameValue(uint8_t typeValue, const uint8_t* payload, size_t length, uint8_t* buffer, size_t bufferSize);
+
+// Per-type encoder (the wire value is a compile-time constant)
+template <MessageType T>
+inline size_t encodeFrame(const uint8_t* payload, size_t length, uint8_t* buffer, size_t bufferSize) {
+    return encodeFrameValue(MessageTraits<T>::VALUE, payload, length, buffer, bufferSize);
+}
+
+/**
+ * @brief Build a frame whose type and payload size are known at compile time
+ *
+ * Usable in constant expressions, e.g. for frames that never change.
+ */
+template <MessageType T, size_t N>
+constexpr std::array<uint8_t, N + FRAME_OVERHEAD> makeFrame(const std::array<uint8_t, N>& payload) {
+    static_assert(N <= MAX_PAYLOAD_LENGTH, "Payload does not fit in a frame");
+
+    std::array<uint8_t, N + FRAME_OVERHEAD> frame{};
+    frame[0] = FRAME_START_BYTE;
+    frame[1] = MessageTraits<T>::VALUE;
+    frame[2] = static_cast<uint8_t>(N);
+
+    uint8_t checksum = frame[0] ^ frame[1] ^ frame[2];
+    for (size_t i = 0; i < N; i++) {
+        frame[FRAME_HEADER_LENGTH + i] = payload[i];
+        checksum ^= payload[i];
+    }
+    frame[FRAME_HEADER_LENGTH + N] = checksum;
+
+    return frame;
+}
+
+/**
+ * @brief Verify a batch of received frames (e.g. one per port per cycle)
+ *
+ * Each entry must hold exactly one frame. A frame is good when its start
+ * byte, type and length field are valid and the XOR of all its bytes,
+ * checksum included, is zero. Checksums are computed together with
+ * xorChecksums().
+ *
+ * @param frames Frame buffers
+ * @param lengths Length of each frame buffer
+ * @param count Number of frames (at most 64)
+ * @return Bitmask with bit i set when frame i is good
+ */
+uint64_t verifyFrames(const uint8_t* const* frames, const size_t* lengths, size_t count);
+
+/**
+ * @class FrameTemplate
+ * @brief Cached outgoing frame that is patched in place
+ *
+ * Cyclic output frames keep their type and length from one cycle to the
+ * next, so the header is built once and only changed payload bytes are
+ * rewritten. The checksum is patched incrementally by XORing out the
+ * old byte and XORing in the new one.
+ */
+class FrameTemplate {
+public:
+    FrameTemplate();
+
+    // Build the complete frame (header, payload and checksum)
+    bool build(MessageType type, const uint8_t* payload, size_t length);
+
+    // Build a frame of a type known at compile time (no type lookup)
+    template <MessageType T>
+    bool build(const uint8_t* payload, size_t length) {
+        m_valid = encodeFrame<T>(payload, length, m_frame, sizeof(m_frame)) > 0;
+        m_type = T;
+        m_length = length;
+        return m_valid;
+    }
+
+    // Check whether the template holds a frame of the given type and length
+    bool matches(MessageType type, size_t length) const {
+        return m_valid && m_type == type && m_length == length;
+    }
+
+    // Rewrite the payload bytes that differ (returns the number of changed bytes)
+    size_t update(const uint8_t* payload, size_t length);
+
+    // Rewrite part of the payload starting at offset
+    bool patch(size_t offset, const uint8_t* data, size_t length);
+
+    // Encoded frame
+    const uint8_t* data() const { return m_frame; }
+    size_t size() const { return m_valid ? m_length + FRAME_OVERHEAD : 0; }
+
+private:
+    uint8_t m_frame[MAX_FRAME_LENGTH];  // Encoded frame
+    size_t m_length;                    // Payload length
+    MessageType m_type;                 // Message type
+    bool m_valid;                       // Frame has been built
+
+    // Replace one payload byte and patch the checksum
+    void setPayloadByte(size_t index, uint8_t value) {
+        uint8_t& byte = m_frame[FRAME_HEADER_LENGTH + index];
+        m_frame[FRAME_HEADER_LENGTH + m_length] ^= byte ^ value;
+        byte = value;
+    }
+};
+
+/**
+ * @struct FrameView
+ * @brief Received frame referencing its payload in the receive buffer
+ *
+ * A view does not own its payload. It stays valid until the buffer it
+ * was decoded from is written to again (i.e. until the next read).
+ */
+struct FrameView {
+    MessageType type;       // Message type
+    const uint8_t* data;    // First payload byte
+    size_t length;          // Payload length
+};
+
+/**
+ * @brief Decode one complete frame of a known type
+ *
+ * @param data Frame bytes (exactly one frame)
+ * @param length Number of bytes
+ * @param frame Receives a view of the payload in data
+ * @return true if data holds a valid frame of type T
+ */
+template <MessageType T>
+inline bool decodeFrame(const uint8_t* data, size_t length, FrameView& frame) {
+    if (length < FRAME_OVERHEAD ||
+        data[0] != FRAME_START_BYTE ||
+        data[1] != MessageTraits<T>::VALUE ||
+        data[2] + FRAME_OVERHEAD != length ||
+        xorChecksum(data, length) != 0) {
+        return false;
+    }
+    frame = FrameView{T, data + FRAME_HEADER_LENGTH, data[2]};
+    return true;
+}
+
+// Decode a frame of type T with a fixed payload size N (data holds N + FRAME_OVERHEAD bytes)
+template <MessageType T, size_t N>
+inline bool decodeFrame(const uint8_t* data, FrameView& frame) {
+    static_assert(N <= MAX_PAYLOAD_LENGTH, "Payload does not fit in a frame");
+    return decodeFrame<T>(data, N + FRAME_OVERHEAD, frame);
+}
+
+/**
+ * @class FrameParser
+ * @brief Extracts IO-Link frames from a buffer of received bytes
+ *
+ * The parser is a state machine (hunt for start byte -> type -> length ->
+ * payload -> checksum) that keeps its position between calls to next().
+ * Line noise and partial frames are skipped: when a candidate fails the
+ * type or checksum check, scanning resumes at the byte after its start
+ * byte, so a frame hidden behind a false start byte is still found.
+ * Every complete frame in a burst is returned by successive calls to
+ * next(); remainder() then gives the leftover tail that may hold the
+ * beginning of a frame not yet fully received.
+ */
+class FrameParser {
+public:
+    // Parse an existing buffer of received bytes
+    FrameParser(const uint8_t* data, size_t length);
+
+    // Decode buffered bytes; returns true when a complete, valid frame is available
+    bool next();
+
+    // Last decoded frame (valid after next() returned true)
+    MessageType getType() const { return m_frameType; }
+    const uint8_t* getPayload() const { return m_data + m_frameStart + FRAME_HEADER_LENGTH; }
+    uint8_t getPayloadLength() const { return m_frameLength; }
+    FrameView getFrame() const { return FrameView{m_frameType, getPayload(), m_frameLength}; }
+
+    // Offset of the undecoded tail (bytes that may start an incomplete frame)
+    size_t remainder() const { return m_start; }
+
+    // Number of buffered bytes not yet examined
+    size_t pending() const { return m_end - m_pos; }
+
+    // Number of bytes still missing from the frame being received (a
+    // minimal frame until its length byte has been decoded)
+    size_t missing() const;
+
+protected:
+    enum class State {
+        HUNT,       // Searching for the start byte
+        TYPE,       // Expecting the message type
+        LENGTH,     // Expecting the payload length
+        PAYLOAD,    // Receiving payload bytes
+        CHECKSUM    // Expecting the checksum
+    };
+
+    const uint8_t* m_data;          // Received bytes
+    size_t m_start;                 // Start of the frame candidate being decoded
+    size_t m_pos;                   // Next byte to examine
+    size_t m_end;                   // End of the received bytes
+    State m_state;                  // Parser state
+    uint8_t m_length;               // Payload length of the candidate
+    uint8_t m_checksum;             // Running checksum of the candidate
+    MessageType m_type;             // Message type of the candidate
+
+    size_t m_frameStart;            // Offset of the last decoded frame
+    uint8_t m_frameLength;          // Payload length of the last decoded frame
+    MessageType m_frameType;        // Message type of the last decoded frame
+
+    // Restart parsing over the given buffer
+    void restart(const uint8_t* data, size_t length);
+
+    // Reject the current candidate and rescan after its start byte
+    void discardCandidate();
+};
+
+/**
+ * @class FrameDecoder
+ * @brief Incremental (streaming) decoder for received IO-Link frames
+ *
+ * Received bytes are appended with write() and consumed by next().
+ * Partial frames are kept between calls, so a frame costs O(bytes
+ * received) in total no matter how many reads it takes to arrive.
+ */
+class FrameDecoder : public FrameParser {
+public:
+    // Capacity of the receive buffer (room for a full frame plus the next one starting)
+    static constexpr size_t BUFFER_SIZE = 2 * MAX_FRAME_LENGTH;
+
+    FrameDecoder();
+    FrameDecoder(const FrameDecoder& other);
+    FrameDecoder& operator=(const FrameDecoder& other);
+
+    // Discard all buffered bytes and restart hunting for a frame
+    void reset();
+
+    // No undecoded bytes are buffered (the next byte read starts a frame)
+    bool empty() const { return m_start == m_end; }
+
+    // Append received bytes to the decoder (returns the number of bytes accepted)
+    // Frames returned by next() remain valid until the next write()
+    size_t write(const uint8_t* data, size_t length);
+    bool write(uint8_t byte);
+
+    // In-place receive: get the free area at the end of the buffer, fill
+    // it (e.g. with Transport::read()) and commit the number of bytes
+    // stored. Like write(), this invalidates frames returned by next().
+    uint8_t* writeBuffer(size_t& space);
+    void commit(size_t count);
+
+private:
+    uint8_t m_buffer[BUFFER_SIZE];  // Received bytes
+
+    // Move undecoded bytes to the front of the buffer
+    void compact();
+};
+
+/**
+ * @class FrameQueue
+ * @brief FIFO of received frame payloads
+ *
+ * Holds frames that were decoded while the receiver was waiting for a
+ * frame of another type, until their own reader takes them. Payloads are
+ * stored back to back with a length octet in front; a popped payload is
+ * returned in place and stays valid until the next push(). When a frame
+ * does not fit, the oldest frames are dropped to make room.
+ */
+class FrameQueue {
+public:
+    // Capacity in bytes (a full-length frame plus a few short ones)
+    static constexpr size_t BUFFER_SIZE = 2 * MAX_FRAME_LENGTH;
+
+    FrameQueue();
+
+    // Discard all queued frames
+    void clear();
+
+    // Append a payload (returns false if older frames had to be dropped)
+    bool push(const uint8_t* payload, size_t length);
+
+    // Remove the oldest payload (returns false if the queue is empty)
+    bool pop(const uint8_t*& payload, size_t& length);
+
+    bool empty() const { return m_head == m_tail; }
+    size_t size() const { return m_count; }
+
+    // Number of frames dropped because the queue was full
+    uint32_t getDropCount() const { return m_dropped; }
+
+private:
+    uint8_t m_buffer[BUFFER_SIZE];  // [length] [payload] records
+    size_t m_head;                  // Offset of the oldest record
+    size_t m_tail;                  // End of the newest record
+    size_t m_count;                 // Number of queued frames
+    uint32_t m_dropped;             // Frames dropped
+};
+
+} // namespace IOLink
+
+#endif // IOLINK_FRAME_H
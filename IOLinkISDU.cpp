@@ -0,0 +1,241 @@
+/**
+ * @file IOLinkISDU.cpp
+ * @brief Segmented parameter transfers (ISDU) implementation
+ */
+
+#include "IOLinkISDU.h"
+#include "IOLinkChecksum.h"
+#include <string.h>
+
+namespace IOLink {
+
+namespace {
+
+// I-Service codes (upper nibble)
+constexpr uint8_t SERVICE_WRITE = 0x1;          // 0x1..0x3 depending on index format
+constexpr uint8_t SERVICE_READ = 0x9;           // 0x9..0xB depending on index format
+constexpr uint8_t SERVICE_WRITE_ERROR = 0x4;
+constexpr uint8_t SERVICE_WRITE_OK = 0x5;
+constexpr uint8_t SERVICE_READ_ERROR = 0xC;
+constexpr uint8_t SERVICE_READ_OK = 0xD;
+
+// Special device replies
+constexpr uint8_t REPLY_NO_SERVICE = 0x00;
+constexpr uint8_t REPLY_BUSY = 0x01;
+
+// Length nibble announcing an ExtLength octet
+constexpr uint8_t LENGTH_EXTENDED = 0x1;
+
+// Longest ISDU whose length fits in the I-Service nibble
+constexpr size_t MAX_SHORT_LENGTH = 15;
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+// IsduTransfer Implementation
+//-----------------------------------------------------------------------------
+
+IsduTransfer::IsduTransfer(size_t segmentLength)
+    : m_segmentLength(segmentLength > 0 ? segmentLength : 1)
+    , m_state(State::IDLE)
+    , m_result(ErrorCode::NONE)
+    , m_read(false)
+    , m_length(0)
+    , m_position(0)
+    , m_segment(0)
+    , m_count(0)
+    , m_deviceError(0)
+    , m_dataOffset(0)
+    , m_dataLength(0) {
+}
+
+ErrorCode IsduTransfer::startRead(uint16_t index, uint8_t subindex) {
+    m_read = true;
+    return buildRequest(SERVICE_READ, index, subindex, nullptr, 0);
+}
+
+ErrorCode IsduTransfer::startWrite(uint16_t index, uint8_t subindex, const uint8_t* data, size_t length) {
+    m_read = false;
+    return buildRequest(SERVICE_WRITE, index, subindex, data, length);
+}
+
+void IsduTransfer::abort(ErrorCode reason) {
+    if (isBusy()) {
+        m_state = State::FAILED;
+        m_result = reason;
+    }
+}
+
+ErrorCode IsduTransfer::buildRequest(uint8_t service, uint16_t index, uint8_t subindex, const uint8_t* data, size_t length) {
+    // Index format: 8-bit index, 8-bit index + subindex, 16-bit index + subindex
+    uint8_t format = (index > 0xFF) ? 2 : (subindex != 0 ? 1 : 0);
+    size_t addressLength = (format == 0) ? 1 : (format == 1 ? 2 : 3);
+
+    // I-Service, index/subindex, data and CHKPDU
+    size_t total = 1 + addressLength + length + 1;
+    bool extended = total > MAX_SHORT_LENGTH;
+    if (extended) {
+        total++;
+    }
+    if (length > ISDU_MAX_DATA_LENGTH || total > ISDU_MAX_LENGTH) {
+        m_state = State::FAILED;
+        m_result = ErrorCode::INVALID_PARAMETER;
+        return m_result;
+    }
+
+    uint8_t* out = m_buffer;
+    *out++ = static_cast<uint8_t>((service + format) << 4) | (extended ? LENGTH_EXTENDED : static_cast<uint8_t>(total));
+    if (extended) {
+        *out++ = static_cast<uint8_t>(total);
+    }
+    if (format == 2) {
+        *out++ = static_cast<uint8_t>(index >> 8);
+    }
+    *out++ = static_cast<uint8_t>(index);
+    if (format != 0) {
+        *out++ = subindex;
+    }
+    if (length > 0) {
+        memcpy(out, data, length);
+        out += length;
+    }
+
+    // CHKPDU makes the XOR of the complete ISDU zero
+    *out = xorChecksum(m_buffer, total - 1);
+
+    m_length = total;
+    m_position = 0;
+    m_segment = 0;
+    m_count = 0;
+    m_deviceError = 0;
+    m_dataOffset = 0;
+    m_dataLength = 0;
+    m_result = ErrorCode::NONE;
+    m_state = State::SENDING;
+    return ErrorCode::NONE;
+}
+
+size_t IsduTransfer::nextRequest(uint8_t* buffer, size_t bufferSize) {
+    if (!isBusy() || bufferSize < 1) {
+        return 0;
+    }
+
+    // First segment of each direction uses START, then the running counter
+    bool first = (m_state == State::SENDING) ? (m_position == 0) : (m_state == State::WAITING);
+    buffer[0] = first ? ISDU_FLOW_START : (m_count & ISDU_FLOW_COUNT_MASK);
+
+    if (m_state != State::SENDING) {
+        return 1;
+    }
+
+    m_segment = m_length - m_position;
+    if (m_segment > m_segmentLength) {
+        m_segment = m_segmentLength;
+    }
+    if (m_segment > bufferSize - 1) {
+        m_segment = bufferSize - 1;
+    }
+    memcpy(buffer + 1, m_buffer + m_position, m_segment);
+    return 1 + m_segment;
+}
+
+ErrorCode IsduTransfer::onResponse(const uint8_t* data, size_t length) {
+    switch (m_state) {
+        case State::SENDING:
+            // Segment acknowledged
+            m_position += m_segment;
+            m_count++;
+            if (m_position >= m_length) {
+                // Request complete, start reading the response
+                m_state = State::WAITING;
+                m_length = 0;
+                m_position = 0;
+                m_count = 0;
+            }
+            return ErrorCode::NONE;
+
+        case State::WAITING:
+            if (length == 0 || data[0] == REPLY_NO_SERVICE || data[0] == REPLY_BUSY) {
+                // Device still processing the request
+                return ErrorCode::NONE;
+            }
+            m_state = State::RECEIVING;
+            break;
+
+        case State::RECEIVING:
+            break;
+
+        default:
+            return ErrorCode::NONE;
+    }
+
+    // Append response octets (never beyond the announced length)
+    size_t room = (m_length > 0 ? m_length : ISDU_MAX_LENGTH) - m_position;
+    if (length > room) {
+        length = room;
+    }
+    memcpy(m_buffer + m_position, data, length);
+    m_position += length;
+    m_count++;
+
+    if (m_length == 0 && !parseResponseLength()) {
+        return m_result;
+    }
+    if (m_length > 0 && m_position >= m_length) {
+        finishResponse();
+    }
+    return m_result;
+}
+
+bool IsduTransfer::parseResponseLength() {
+    uint8_t lengthNibble = m_buffer[0] & 0x0F;
+    if (lengthNibble == LENGTH_EXTENDED) {
+        if (m_position < 2) {
+            // ExtLength arrives with the next segment
+            return true;
+        }
+        m_length = m_buffer[1];
+    } else {
+        m_length = lengthNibble;
+    }
+
+    if (m_length < 2 || m_length > ISDU_MAX_LENGTH) {
+        m_state = State::FAILED;
+        m_result = ErrorCode::COMMUNICATION_ERROR;
+        return false;
+    }
+
+    // Octets beyond the ISDU in the first segment are padding
+    if (m_position > m_length) {
+        m_position = m_length;
+    }
+    return true;
+}
+
+void IsduTransfer::finishResponse() {
+    if (xorChecksum(m_buffer, m_length) != 0) {
+        m_state = State::FAILED;
+        m_result = ErrorCode::COMMUNICATION_ERROR;
+        return;
+    }
+
+    uint8_t service = m_buffer[0] >> 4;
+    size_t offset = ((m_buffer[0] & 0x0F) == LENGTH_EXTENDED) ? 2 : 1;
+    size_t dataLength = m_length - offset - 1;
+
+    if (service == (m_read ? SERVICE_READ_OK : SERVICE_WRITE_OK)) {
+        m_dataOffset = offset;
+        m_dataLength = m_read ? dataLength : 0;
+        m_state = State::DONE;
+        m_result = ErrorCode::NONE;
+    } else if (service == (m_read ? SERVICE_READ_ERROR : SERVICE_WRITE_ERROR) && dataLength >= 2) {
+        m_deviceError = static_cast<uint16_t>((m_buffer[offset] << 8) | m_buffer[offset + 1]);
+        m_state = State::FAILED;
+        m_result = ErrorCode::DEVICE_ERROR;
+    } else {
+        m_state = State::FAILED;
+        m_result = ErrorCode::COMMUNICATION_ERROR;
+    }
+}
+
+} // namespace IOLink
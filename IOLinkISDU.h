@@ -0,0 +1,109 @@
+/**
+ * @file IOLinkISDU.h
+ * @brief Segmented parameter transfers (ISDU, IEC 61131-9)
+ *
+ * Parameters are read and written with Indexed Service Data Units that
+ * can be larger than one message. An IsduTransfer splits the request
+ * into segments and reassembles the device response into a
+ * preallocated buffer, one segment per call, so a transfer can be
+ * interleaved with the cyclic process data exchange.
+ *
+ * Each master segment is [FlowCTRL] [ISDU octets...]. While the response
+ * is read, the master sends [FlowCTRL] only and the device replies with
+ * the next response octets.
+ */
+
+#ifndef IOLINK_ISDU_H
+#define IOLINK_ISDU_H
+
+#include "IOLinkTypes.h"
+#include <stddef.h>
+#include <stdint.h>
+
+namespace IOLink {
+
+// ISDU limits
+constexpr size_t ISDU_MAX_LENGTH = 238;         // Complete ISDU (service, length, index, data, check)
+constexpr size_t ISDU_MAX_DATA_LENGTH = 232;    // Parameter data in one ISDU
+constexpr size_t ISDU_SEGMENT_LENGTH = 8;       // Default ISDU octets per segment
+constexpr uint32_t ISDU_TIMEOUT_MS = 5000;      // Maximum duration of a transfer
+
+// FlowCTRL values
+constexpr uint8_t ISDU_FLOW_START = 0x10;       // First segment of a request or response
+constexpr uint8_t ISDU_FLOW_IDLE = 0x11;        // No transfer in progress
+constexpr uint8_t ISDU_FLOW_ABORT = 0x1F;       // Abort the transfer
+constexpr uint8_t ISDU_FLOW_COUNT_MASK = 0x0F;  // Segment counter for following segments
+
+/**
+ * @class IsduTransfer
+ * @brief Master side state machine of one ISDU read or write
+ */
+class IsduTransfer {
+public:
+    enum class State {
+        IDLE,       // No transfer started
+        SENDING,    // Sending request segments
+        WAITING,    // Request sent, device is busy
+        RECEIVING,  // Receiving response segments
+        DONE,       // Transfer completed (see getResult())
+        FAILED      // Transfer failed (see getResult())
+    };
+
+    explicit IsduTransfer(size_t segmentLength = ISDU_SEGMENT_LENGTH);
+
+    // Start a transfer (any transfer in progress is dropped)
+    ErrorCode startRead(uint16_t index, uint8_t subindex);
+    ErrorCode startWrite(uint16_t index, uint8_t subindex, const uint8_t* data, size_t length);
+
+    // Abort the transfer in progress
+    void abort(ErrorCode reason = ErrorCode::TIMEOUT);
+
+    // Next master segment to send (returns its length, 0 when nothing to send)
+    // The segment is repeated until onResponse() accepts the device reply.
+    size_t nextRequest(uint8_t* buffer, size_t bufferSize);
+
+    // Process the device reply to the last segment
+    ErrorCode onResponse(const uint8_t* data, size_t length);
+
+    // Transfer status
+    State getState() const { return m_state; }
+    bool isBusy() const { return m_state == State::SENDING || m_state == State::WAITING || m_state == State::RECEIVING; }
+    ErrorCode getResult() const { return m_result; }
+
+    // Device error (ErrorCode << 8 | AdditionalCode) of a negative response
+    uint16_t getDeviceError() const { return m_deviceError; }
+
+    // Parameter data of a completed read (valid until the next transfer starts)
+    const uint8_t* getData() const { return m_buffer + m_dataOffset; }
+    size_t getDataLength() const { return m_dataLength; }
+
+    // Segment size
+    void setSegmentLength(size_t segmentLength) { m_segmentLength = segmentLength > 0 ? segmentLength : 1; }
+
+private:
+    uint8_t m_buffer[ISDU_MAX_LENGTH];  // Request while sending, response while receiving
+    size_t m_segmentLength;             // ISDU octets per request segment
+    State m_state;                      // Transfer state
+    ErrorCode m_result;                 // Result of the transfer
+    bool m_read;                        // Read (true) or write (false) transfer
+    size_t m_length;                    // Request length, or expected response length (0 = not known yet)
+    size_t m_position;                  // Octets sent or received so far
+    size_t m_segment;                   // Length of the last request segment
+    uint8_t m_count;                    // FlowCTRL segment counter
+    uint16_t m_deviceError;             // Device error of a negative response
+    size_t m_dataOffset;                // Offset of the response data
+    size_t m_dataLength;                // Length of the response data
+
+    // Build the request ISDU
+    ErrorCode buildRequest(uint8_t service, uint16_t index, uint8_t subindex, const uint8_t* data, size_t length);
+
+    // Determine the response length once its header has arrived
+    bool parseResponseLength();
+
+    // Check and decode the complete response
+    void finishResponse();
+};
+
+} // namespace IOLink
+
+#endif // IOLINK_ISDU_H
@@ -0,0 +1,687 @@
+/**
+ * @file IOLinkIoUring.cpp
+ * @brief io_uring transport backend implementation
+ */
+
+#include "IOLinkIoUring.h"
+
+#if defined(IOLINK_PLATFORM_POSIX) && defined(IOLINK_USE_IO_URING)
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace IOLink {
+
+namespace {
+
+// Request kinds encoded in the low bits of the user data (slot index above)
+constexpr uint64_t REQUEST_READ = 1;
+constexpr uint64_t REQUEST_WRITE = 2;
+constexpr uint64_t REQUEST_CANCEL = 3;
+constexpr uint64_t REQUEST_MASK = 0x3;
+constexpr unsigned REQUEST_SHIFT = 2;
+
+// Multishot read opcode (Linux 6.7), missing from older uapi headers
+constexpr uint8_t OP_READ_MULTISHOT = 49;
+
+// Provided buffer group of multishot reads
+constexpr uint16_t BUFFER_GROUP = 0;
+
+// Time allowed for a port's requests to finish when it is detached
+constexpr uint32_t DETACH_TIMEOUT_US = 100000;
+
+// Raw io_uring system calls (no liburing)
+int ringSetup(unsigned entries, struct io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags, const void* arg, size_t argSize) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argSize));
+}
+
+int ringRegister(int fd, unsigned opcode, const void* arg, unsigned count) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+// Ring indices shared with the kernel
+inline unsigned loadAcquire(const unsigned* index) {
+    return __atomic_load_n(index, __ATOMIC_ACQUIRE);
+}
+
+inline void storeRelease(unsigned* index, unsigned value) {
+    __atomic_store_n(index, value, __ATOMIC_RELEASE);
+}
+
+// Map memory shared with the kernel (nullptr on failure)
+void* mapMemory(size_t size, int fd, off_t offset) {
+    int flags = (fd >= 0) ? (MAP_SHARED | MAP_POPULATE) : (MAP_PRIVATE | MAP_ANONYMOUS);
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd, offset);
+    return (memory == MAP_FAILED) ? nullptr : memory;
+}
+
+// Check whether the kernel supports an opcode
+bool isOpcodeSupported(int ringFd, uint8_t opcode) {
+    size_t size = sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op);
+    std::vector<uint8_t> memory(size, 0);
+    struct io_uring_probe* probe = reinterpret_cast<struct io_uring_probe*>(memory.data());
+    if (ringRegister(ringFd, IORING_REGISTER_PROBE, probe, 256) < 0) {
+        return false;
+    }
+    return opcode <= probe->last_op && (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+// IoUringContext Implementation
+//-----------------------------------------------------------------------------
+
+constexpr unsigned IoUringContext::QUEUE_DEPTH;
+constexpr size_t IoUringContext::READ_CHUNK_SIZE;
+constexpr size_t IoUringContext::TX_BUFFER_SIZE;
+
+IoUringContext::IoUringContext()
+    : m_ringFd(-1)
+    , m_multishot(false)
+    , m_sqRing(nullptr)
+    , m_sqRingSize(0)
+    , m_sqHead(nullptr)
+    , m_sqTail(nullptr)
+    , m_sqMask(0)
+    , m_sqArray(nullptr)
+    , m_sqes(nullptr)
+    , m_sqesSize(0)
+    , m_toSubmit(0)
+    , m_cqRing(nullptr)
+    , m_cqRingSize(0)
+    , m_cqHead(nullptr)
+    , m_cqTail(nullptr)
+    , m_cqMask(0)
+    , m_cqes(nullptr)
+    , m_arena(nullptr)
+    , m_arenaSize(0)
+    , m_providedBuffers(nullptr)
+    , m_bufferRing(nullptr)
+    , m_bufferCount(0)
+    , m_bufferTail(0)
+    , m_enterCount(0)
+    , m_overrunCount(0) {
+}
+
+IoUringContext::~IoUringContext() {
+    close();
+}
+
+ErrorCode IoUringContext::open(size_t maxPorts) {
+    if (maxPorts == 0) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    close();
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    m_ringFd = ringSetup(QUEUE_DEPTH, &params);
+    if (m_ringFd < 0) {
+        return ErrorCode::NOT_SUPPORTED;
+    }
+
+    // Waiting with a timeout needs IORING_ENTER_EXT_ARG (Linux 5.11)
+    if (!(params.features & IORING_FEAT_EXT_ARG)) {
+        close();
+        return ErrorCode::NOT_SUPPORTED;
+    }
+
+    // Map the submission and completion rings
+    m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap && m_cqRingSize > m_sqRingSize) {
+        m_sqRingSize = m_cqRingSize;
+    }
+
+    m_sqRing = mapMemory(m_sqRingSize, m_ringFd, IORING_OFF_SQ_RING);
+    m_cqRing = singleMap ? m_sqRing : mapMemory(m_cqRingSize, m_ringFd, IORING_OFF_CQ_RING);
+    m_sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    m_sqes = static_cast<struct io_uring_sqe*>(mapMemory(m_sqesSize, m_ringFd, IORING_OFF_SQES));
+    if (m_sqRing == nullptr || m_cqRing == nullptr || m_sqes == nullptr) {
+        close();
+        return ErrorCode::NOT_SUPPORTED;
+    }
+
+    uint8_t* sq = static_cast<uint8_t*>(m_sqRing);
+    m_sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    m_sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    m_sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+    uint8_t* cq = static_cast<uint8_t*>(m_cqRing);
+    m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    m_cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    // Buffer memory: per port slots, then two provided buffers per port
+    m_bufferCount = 8;
+    while (m_bufferCount < 2 * maxPorts) {
+        m_bufferCount *= 2;
+    }
+    size_t slotSize = READ_CHUNK_SIZE + 2 * TX_BUFFER_SIZE;
+    size_t registeredSize = maxPorts * slotSize;
+    m_arenaSize = registeredSize + m_bufferCount * READ_CHUNK_SIZE;
+    m_arena = static_cast<uint8_t*>(mapMemory(m_arenaSize, -1, 0));
+    if (m_arena == nullptr) {
+        close();
+        return ErrorCode::NOT_SUPPORTED;
+    }
+    m_providedBuffers = m_arena + registeredSize;
+
+    // Register the slot buffers once so reads and writes skip the page pinning
+    struct iovec registered = { m_arena, registeredSize };
+    if (ringRegister(m_ringFd, IORING_REGISTER_BUFFERS, &registered, 1) < 0) {
+        close();
+        return ErrorCode::NOT_SUPPORTED;
+    }
+
+    m_slots.assign(maxPorts, Slot());
+    for (size_t i = 0; i < maxPorts; i++) {
+        Slot& slot = m_slots[i];
+        uint8_t* memory = m_arena + i * slotSize;
+        slot.transport = nullptr;
+        slot.fd = -1;
+        slot.rxChunk = memory;
+        slot.txBuffer[0] = memory + READ_CHUNK_SIZE;
+        slot.txBuffer[1] = memory + READ_CHUNK_SIZE + TX_BUFFER_SIZE;
+    }
+
+    // Multishot reads are optional, single-shot reads work everywhere
+    m_multishot = isOpcodeSupported(m_ringFd, OP_READ_MULTISHOT) && setupBufferRing() == ErrorCode::NONE;
+
+    return ErrorCode::NONE;
+}
+
+void IoUringContext::close() {
+    // Attached transports fall back to plain termios I/O
+    for (Slot& slot : m_slots) {
+        if (slot.transport != nullptr) {
+            slot.transport->m_slot = IoUringTransport::NO_SLOT;
+        }
+    }
+    m_slots.clear();
+
+    // Closing the ring cancels all requests in flight
+    if (m_ringFd >= 0) {
+        ::close(m_ringFd);
+        m_ringFd = -1;
+    }
+    if (m_bufferRing != nullptr) {
+        munmap(m_bufferRing, m_bufferCount * sizeof(struct io_uring_buf));
+        m_bufferRing = nullptr;
+    }
+    if (m_arena != nullptr) {
+        munmap(m_arena, m_arenaSize);
+        m_arena = nullptr;
+    }
+    if (m_sqes != nullptr) {
+        munmap(m_sqes, m_sqesSize);
+        m_sqes = nullptr;
+    }
+    if (m_cqRing != nullptr && m_cqRing != m_sqRing) {
+        munmap(m_cqRing, m_cqRingSize);
+    }
+    m_cqRing = nullptr;
+    if (m_sqRing != nullptr) {
+        munmap(m_sqRing, m_sqRingSize);
+        m_sqRing = nullptr;
+    }
+
+    m_multishot = false;
+    m_toSubmit = 0;
+}
+
+void IoUringContext::submit() {
+    if (!isOpen()) {
+        return;
+    }
+
+    reap();
+    prepare();
+    if (m_toSubmit > 0) {
+        enter(false, 0);
+    }
+    reap();
+}
+
+void IoUringContext::wait(uint32_t timeoutUs) {
+    if (!isOpen()) {
+        return;
+    }
+
+    reap();
+    prepare();
+    enter(true, timeoutUs);
+    reap();
+}
+
+ErrorCode IoUringContext::attach(IoUringTransport& transport, int fd, size_t& slot) {
+    for (size_t i = 0; i < m_slots.size(); i++) {
+        if (m_slots[i].transport == nullptr) {
+            Slot& free = m_slots[i];
+            free.transport = &transport;
+            free.fd = fd;
+            free.stage = 0;
+            free.staged = 0;
+            free.flightLength = 0;
+            free.flightDone = 0;
+            free.writing = false;
+            free.reading = false;
+            free.failed = false;
+            slot = i;
+
+            // Arm the first read right away
+            submit();
+            return ErrorCode::NONE;
+        }
+    }
+
+    // More ports than passed to open()
+    return ErrorCode::INVALID_PARAMETER;
+}
+
+void IoUringContext::detach(size_t slot) {
+    if (!isOpen() || slot >= m_slots.size()) {
+        return;
+    }
+
+    // Stop re-arming, cancel what is in flight and wait for it to finish
+    Slot& port = m_slots[slot];
+    port.failed = true;
+    port.staged = 0;
+    port.flightDone = port.flightLength;
+    if (port.reading || port.writing) {
+        queueCancel(slot);
+        uint32_t waited = 0;
+        while ((port.reading || port.writing) && waited < DETACH_TIMEOUT_US) {
+            wait(1000);
+            waited += 1000;
+        }
+    }
+
+    port.transport = nullptr;
+    port.fd = -1;
+}
+
+size_t IoUringContext::stage(size_t slot, const uint8_t* data, size_t length) {
+    Slot& port = m_slots[slot];
+    size_t count = 0;
+
+    while (count < length && !port.failed) {
+        size_t space = TX_BUFFER_SIZE - port.staged;
+        if (space == 0) {
+            // Staging buffer full: send it once the previous write has finished
+            submit();
+            if (port.staged == TX_BUFFER_SIZE) {
+                wait(1000);
+            }
+            continue;
+        }
+
+        if (space > length - count) {
+            space = length - count;
+        }
+        memcpy(port.txBuffer[port.stage] + port.staged, data + count, space);
+        port.staged += space;
+        count += space;
+    }
+    return count;
+}
+
+ErrorCode IoUringContext::setupBufferRing() {
+    size_t ringSize = m_bufferCount * sizeof(struct io_uring_buf);
+    m_bufferRing = mapMemory(ringSize, -1, 0);
+    if (m_bufferRing == nullptr) {
+        return ErrorCode::NOT_SUPPORTED;
+    }
+
+    struct io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<uint64_t>(m_bufferRing);
+    reg.ring_entries = m_bufferCount;
+    reg.bgid = BUFFER_GROUP;
+    if (ringRegister(m_ringFd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        munmap(m_bufferRing, ringSize);
+        m_bufferRing = nullptr;
+        return ErrorCode::NOT_SUPPORTED;
+    }
+
+    // Hand all buffers to the kernel
+    m_bufferTail = 0;
+    for (unsigned id = 0; id < m_bufferCount; id++) {
+        recycleBuffer(id);
+    }
+    return ErrorCode::NONE;
+}
+
+struct io_uring_sqe* IoUringContext::getSqe() {
+    unsigned tail = *m_sqTail;
+    if (tail - loadAcquire(m_sqHead) > m_sqMask) {
+        // Queue full: submit what is queued so far
+        enter(false, 0);
+        if (tail - loadAcquire(m_sqHead) > m_sqMask) {
+            return nullptr;
+        }
+    }
+
+    // The kernel only consumes entries in io_uring_enter() (no SQ polling
+    // thread), so the entry may be filled in after publishing the tail
+    unsigned index = tail & m_sqMask;
+    m_sqArray[index] = index;
+    struct io_uring_sqe* sqe = &m_sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    storeRelease(m_sqTail, tail + 1);
+    m_toSubmit++;
+    return sqe;
+}
+
+void IoUringContext::queueRead(size_t slot) {
+    struct io_uring_sqe* sqe = getSqe();
+    if (sqe == nullptr) {
+        return;
+    }
+
+    Slot& port = m_slots[slot];
+    sqe->fd = port.fd;
+    sqe->off = static_cast<uint64_t>(-1);
+    sqe->user_data = (static_cast<uint64_t>(slot) << REQUEST_SHIFT) | REQUEST_READ;
+    if (m_multishot) {
+        // Stays armed and picks a provided buffer for every chunk received
+        sqe->opcode = OP_READ_MULTISHOT;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = BUFFER_GROUP;
+    } else {
+        sqe->opcode = IORING_OP_READ_FIXED;
+        sqe->addr = reinterpret_cast<uint64_t>(port.rxChunk);
+        sqe->len = READ_CHUNK_SIZE;
+        sqe->buf_index = 0;
+    }
+    port.reading = true;
+}
+
+void IoUringContext::queueWrite(size_t slot) {
+    struct io_uring_sqe* sqe = getSqe();
+    if (sqe == nullptr) {
+        return;
+    }
+
+    Slot& port = m_slots[slot];
+    sqe->opcode = IORING_OP_WRITE_FIXED;
+    sqe->fd = port.fd;
+    sqe->off = static_cast<uint64_t>(-1);
+    sqe->addr = reinterpret_cast<uint64_t>(port.txBuffer[port.stage ^ 1] + port.flightDone);
+    sqe->len = static_cast<uint32_t>(port.flightLength - port.flightDone);
+    sqe->buf_index = 0;
+    sqe->user_data = (static_cast<uint64_t>(slot) << REQUEST_SHIFT) | REQUEST_WRITE;
+    port.writing = true;
+}
+
+void IoUringContext::queueCancel(size_t slot) {
+    struct io_uring_sqe* sqe = getSqe();
+    if (sqe == nullptr) {
+        return;
+    }
+
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = m_slots[slot].fd;
+    sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+    sqe->user_data = (static_cast<uint64_t>(slot) << REQUEST_SHIFT) | REQUEST_CANCEL;
+}
+
+void IoUringContext::prepare() {
+    for (size_t i = 0; i < m_slots.size(); i++) {
+        Slot& port = m_slots[i];
+        if (port.transport == nullptr || port.failed) {
+            continue;
+        }
+
+        // Continue a partial write, or send the staged frames
+        if (!port.writing) {
+            if (port.flightDone < port.flightLength) {
+                queueWrite(i);
+            } else if (port.staged > 0) {
+                port.stage ^= 1;
+                port.flightLength = port.staged;
+                port.flightDone = 0;
+                port.staged = 0;
+                queueWrite(i);
+            }
+        }
+
+        // Re-arm the read once there is room for another chunk
+        if (!port.reading && port.transport->m_rxBuffer.space() >= READ_CHUNK_SIZE) {
+            queueRead(i);
+        }
+    }
+}
+
+void IoUringContext::enter(bool wait, uint32_t timeoutUs) {
+    unsigned flags = 0;
+    unsigned minComplete = 0;
+    struct io_uring_getevents_arg arg;
+    struct __kernel_timespec timeout;
+    const void* argument = nullptr;
+    size_t argumentSize = 0;
+
+    if (wait) {
+        timeout.tv_sec = timeoutUs / 1000000;
+        timeout.tv_nsec = static_cast<long long>(timeoutUs % 1000000) * 1000;
+        memset(&arg, 0, sizeof(arg));
+        arg.sigmask_sz = _NSIG / 8;
+        arg.ts = reinterpret_cast<uint64_t>(&timeout);
+        flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+        minComplete = 1;
+        argument = &arg;
+        argumentSize = sizeof(arg);
+    }
+
+    int result;
+    do {
+        result = ringEnter(m_ringFd, m_toSubmit, minComplete, flags, argument, argumentSize);
+        m_enterCount++;
+    } while (result < 0 && errno == EINTR);
+
+    // Entries still queued after an error are submitted with the next call
+    m_toSubmit = *m_sqTail - loadAcquire(m_sqHead);
+}
+
+void IoUringContext::reap() {
+    unsigned head = *m_cqHead;
+    unsigned tail = loadAcquire(m_cqTail);
+    while (head != tail) {
+        complete(m_cqes[head & m_cqMask]);
+        head++;
+    }
+    storeRelease(m_cqHead, head);
+}
+
+void IoUringContext::complete(const struct io_uring_cqe& cqe) {
+    size_t index = static_cast<size_t>(cqe.user_data >> REQUEST_SHIFT);
+    if (index >= m_slots.size()) {
+        return;
+    }
+    Slot& port = m_slots[index];
+
+    switch (cqe.user_data & REQUEST_MASK) {
+        case REQUEST_READ: {
+            bool buffer = (cqe.flags & IORING_CQE_F_BUFFER) != 0;
+            unsigned bufferId = cqe.flags >> IORING_CQE_BUFFER_SHIFT;
+            const uint8_t* data = buffer ? m_providedBuffers + bufferId * READ_CHUNK_SIZE : port.rxChunk;
+
+            if (cqe.res > 0 && port.transport != nullptr) {
+                size_t received = static_cast<size_t>(cqe.res);
+                m_overrunCount += received - port.transport->m_rxBuffer.push(data, received);
+            }
+            if (buffer) {
+                recycleBuffer(bufferId);
+            }
+
+            // A multishot read stays armed while the kernel sets F_MORE
+            if (!m_multishot || !(cqe.flags & IORING_CQE_F_MORE)) {
+                port.reading = false;
+            }
+
+            if (cqe.res == -EINVAL && m_multishot) {
+                // Device does not support multishot reads, use single-shot reads
+                m_multishot = false;
+            } else if (cqe.res == 0 || (cqe.res < 0 && cqe.res != -ENOBUFS && cqe.res != -EAGAIN && cqe.res != -EINTR)) {
+                // End of file (device gone) or error: stop reading
+                port.failed = true;
+            }
+            break;
+        }
+
+        case REQUEST_WRITE:
+            port.writing = false;
+            if (cqe.res > 0) {
+                port.flightDone += static_cast<size_t>(cqe.res);
+            } else {
+                // Drop the frames of a failed write
+                port.flightDone = port.flightLength;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void IoUringContext::recycleBuffer(unsigned bufferId) {
+    // The ring is an array of io_uring_buf whose first resv field is the
+    // tail (struct io_uring_buf_ring is not used: its flexible array member
+    // has a different layout in C++)
+    struct io_uring_buf* ring = static_cast<struct io_uring_buf*>(m_bufferRing);
+    struct io_uring_buf& entry = ring[m_bufferTail & (m_bufferCount - 1)];
+    entry.addr = reinterpret_cast<uint64_t>(m_providedBuffers + bufferId * READ_CHUNK_SIZE);
+    entry.len = READ_CHUNK_SIZE;
+    entry.bid = static_cast<uint16_t>(bufferId);
+    m_bufferTail++;
+    __atomic_store_n(&ring[0].resv, static_cast<uint16_t>(m_bufferTail), __ATOMIC_RELEASE);
+}
+
+//-----------------------------------------------------------------------------
+// IoUringTransport Implementation
+//-----------------------------------------------------------------------------
+
+constexpr size_t IoUringTransport::RX_BUFFER_SIZE;
+constexpr size_t IoUringTransport::NO_SLOT;
+
+IoUringTransport::IoUringTransport(IoUringContext& context, const char* devicePath)
+    : m_context(context)
+    , m_serial(devicePath)
+    , m_slot(NO_SLOT) {
+}
+
+IoUringTransport::~IoUringTransport() {
+    close();
+}
+
+ErrorCode IoUringTransport::configure(uint32_t baudRate) {
+    // Reconfigure detached, termios flushes the device
+    if (m_slot != NO_SLOT) {
+        m_context.detach(m_slot);
+        m_slot = NO_SLOT;
+    }
+
+    ErrorCode result = m_serial.configure(baudRate);
+    if (result != ErrorCode::NONE) {
+        return result;
+    }
+    m_rxBuffer.reset();
+
+    if (!m_context.isOpen()) {
+        // io_uring unavailable: plain termios I/O
+        return ErrorCode::NONE;
+    }
+
+    // With VMIN 0 a tty read completes at once with 0 bytes (end of file);
+    // VMIN 1 makes io_uring wait for data (the descriptor stays non-blocking)
+    struct termios tio;
+    if (tcgetattr(m_serial.getFd(), &tio) != 0) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+    tio.c_cc[VMIN] = 1;
+    if (tcsetattr(m_serial.getFd(), TCSANOW, &tio) != 0) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+
+    return m_context.attach(*this, m_serial.getFd(), m_slot);
+}
+
+size_t IoUringTransport::available() {
+    if (m_slot == NO_SLOT) {
+        return m_serial.available();
+    }
+    m_context.submit();
+    return m_rxBuffer.size();
+}
+
+int IoUringTransport::readByte() {
+    uint8_t byte;
+    if (read(&byte, 1) != 1) {
+        return -1;
+    }
+    return byte;
+}
+
+size_t IoUringTransport::read(uint8_t* buffer, size_t length) {
+    if (m_slot == NO_SLOT) {
+        return m_serial.read(buffer, length);
+    }
+
+    // Sends staged frames and collects completions (a system call only if
+    // something was staged or a read has to be re-armed)
+    m_context.submit();
+    return m_rxBuffer.pop(buffer, length);
+}
+
+bool IoUringTransport::writeByte(uint8_t byte) {
+    return write(&byte, 1) == 1;
+}
+
+size_t IoUringTransport::write(const uint8_t* data, size_t length) {
+    if (m_slot == NO_SLOT) {
+        return m_serial.write(data, length);
+    }
+    return m_context.stage(m_slot, data, length);
+}
+
+ErrorCode IoUringTransport::waitReadable(uint32_t timeoutUs) {
+    if (m_slot == NO_SLOT) {
+        return m_serial.waitReadable(timeoutUs);
+    }
+
+    m_context.submit();
+    if (m_rxBuffer.empty()) {
+        // Returns on any completion, possibly one of another port
+        m_context.wait(timeoutUs);
+    }
+    return m_rxBuffer.empty() ? ErrorCode::TIMEOUT : ErrorCode::NONE;
+}
+
+void IoUringTransport::close() {
+    if (m_slot != NO_SLOT) {
+        m_context.detach(m_slot);
+        m_slot = NO_SLOT;
+    }
+    m_serial.close();
+}
+
+} // namespace IOLink
+
+#endif // IOLINK_PLATFORM_POSIX && IOLINK_USE_IO_URING
@@ -0,0 +1,197 @@
+/**
+ * @file IOLinkIoUring.h
+ * @brief io_uring transport backend for Linux gateways with many ports
+ *
+ * Optional backend, built only when IOLINK_USE_IO_URING is defined. All
+ * ports share one IoUringContext. Frames written to the ports during a
+ * cycle are staged in registered buffers and go out together with a
+ * single io_uring_enter() call, and reads stay armed in the kernel
+ * (multishot reads into a provided buffer ring where the kernel supports
+ * them, registered-buffer reads otherwise). Collecting received data
+ * only reads the completion queue, so it needs no system call.
+ *
+ * The backend uses the raw system calls, not liburing. If the kernel
+ * does not provide io_uring (or forbids it), IoUringContext::open()
+ * fails and every IoUringTransport behaves like a PosixSerialTransport,
+ * so the application keeps working on the termios/epoll path.
+ */
+
+#ifndef IOLINK_IO_URING_H
+#define IOLINK_IO_URING_H
+
+#include "IOLinkConfig.h"
+
+#if defined(IOLINK_PLATFORM_POSIX) && defined(IOLINK_USE_IO_URING)
+
+#include "IOLinkTransport.h"
+#include "IOLinkFrame.h"
+#include "IOLinkPosix.h"
+#include "IOLinkRingBuffer.h"
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace IOLink {
+
+class IoUringTransport;
+
+/**
+ * @class IoUringContext
+ * @brief io_uring instance shared by the ports of a gateway
+ *
+ * Single-threaded: the context and its transports must be used from
+ * one thread.
+ */
+class IoUringContext {
+public:
+    static constexpr unsigned QUEUE_DEPTH = 256;                    // Submission queue entries
+    static constexpr size_t READ_CHUNK_SIZE = 256;                  // Bytes per read request or provided buffer
+    static constexpr size_t TX_BUFFER_SIZE = 2 * MAX_FRAME_LENGTH;  // Staged bytes per port (double-buffered)
+
+    IoUringContext();
+    ~IoUringContext();
+
+    IoUringContext(const IoUringContext&) = delete;
+    IoUringContext& operator=(const IoUringContext&) = delete;
+
+    // Create the ring and register the buffers of up to maxPorts ports
+    // (NOT_SUPPORTED if the kernel lacks io_uring or one of the features used)
+    ErrorCode open(size_t maxPorts = 64);
+    void close();
+    bool isOpen() const { return m_ringFd >= 0; }
+
+    // Reads use multishot requests with provided buffers
+    bool usesMultishot() const { return m_multishot; }
+
+    // Submit the frames staged on all ports (and re-arm reads) with one
+    // io_uring_enter() call, then collect completions without waiting
+    void submit();
+
+    // Like submit(), but wait up to timeoutUs for at least one completion
+    void wait(uint32_t timeoutUs);
+
+    // Statistics: io_uring_enter() calls made, received bytes dropped because a port's buffer was full
+    uint64_t getEnterCount() const { return m_enterCount; }
+    uint64_t getOverrunCount() const { return m_overrunCount; }
+
+private:
+    friend class IoUringTransport;
+
+    // Per-port state
+    struct Slot {
+        IoUringTransport* transport;    // Attached transport (nullptr if free)
+        int fd;                         // Device file descriptor
+        uint8_t* rxChunk;               // Registered buffer of single-shot reads
+        uint8_t* txBuffer[2];           // Registered staging and in-flight transmit buffers
+        uint8_t stage;                  // Index of the staging buffer
+        size_t staged;                  // Bytes staged for the next submission
+        size_t flightLength;            // Bytes of the write in flight
+        size_t flightDone;              // Bytes of the write in flight already written
+        bool writing;                   // Write request in flight
+        bool reading;                   // Read request armed
+        bool failed;                    // Device reported end of file or an error
+    };
+
+    int m_ringFd;                       // io_uring file descriptor
+    bool m_multishot;                   // Multishot reads with provided buffers
+
+    // Submission queue (mapped from the kernel)
+    void* m_sqRing;                     // Mapped SQ ring
+    size_t m_sqRingSize;                // Size of the SQ ring mapping
+    unsigned* m_sqHead;                 // Consumed by the kernel
+    unsigned* m_sqTail;                 // Produced by us
+    unsigned m_sqMask;                  // Index mask
+    unsigned* m_sqArray;                // SQE index array
+    io_uring_sqe* m_sqes;               // Submission queue entries
+    size_t m_sqesSize;                  // Size of the SQE mapping
+    unsigned m_toSubmit;                // Entries queued since the last io_uring_enter()
+
+    // Completion queue (mapped from the kernel)
+    void* m_cqRing;                     // Mapped CQ ring (may equal m_sqRing)
+    size_t m_cqRingSize;                // Size of the CQ ring mapping
+    unsigned* m_cqHead;                 // Consumed by us
+    unsigned* m_cqTail;                 // Produced by the kernel
+    unsigned m_cqMask;                  // Index mask
+    io_uring_cqe* m_cqes;               // Completion queue entries
+
+    // Registered memory: per port [rx chunk][tx A][tx B], then the provided buffers
+    uint8_t* m_arena;                   // Buffer memory
+    size_t m_arenaSize;                 // Size of the buffer memory
+    uint8_t* m_providedBuffers;         // Provided buffers of multishot reads
+    void* m_bufferRing;                 // Provided buffer ring shared with the kernel
+    unsigned m_bufferCount;             // Number of provided buffers (power of two)
+    unsigned m_bufferTail;              // Tail of the provided buffer ring
+
+    std::vector<Slot> m_slots;          // Port slots
+    uint64_t m_enterCount;              // io_uring_enter() calls made
+    uint64_t m_overrunCount;            // Received bytes dropped
+
+    // Port attachment (used by IoUringTransport)
+    ErrorCode attach(IoUringTransport& transport, int fd, size_t& slot);
+    void detach(size_t slot);
+    size_t stage(size_t slot, const uint8_t* data, size_t length);
+
+    ErrorCode setupBufferRing();
+    io_uring_sqe* getSqe();
+    void queueRead(size_t slot);
+    void queueWrite(size_t slot);
+    void queueCancel(size_t slot);
+    void prepare();
+    void enter(bool wait, uint32_t timeoutUs);
+    void reap();
+    void complete(const io_uring_cqe& cqe);
+    void recycleBuffer(unsigned bufferId);
+};
+
+/**
+ * @class IoUringTransport
+ * @brief Serial port transport whose I/O goes through an IoUringContext
+ *
+ * write() stages the bytes; they are sent by the next submit() or
+ * wait() of the context, or by the next read()/available() call on any
+ * port of the context, so a request is never left unsent while the
+ * master waits for its reply.
+ */
+class IoUringTransport : public Transport {
+public:
+    static constexpr size_t RX_BUFFER_SIZE = 4096;  // Received bytes buffered per port (power of two)
+
+    // Constructor with the shared context and the path of the serial device
+    IoUringTransport(IoUringContext& context, const char* devicePath);
+    ~IoUringTransport() override;
+
+    IoUringTransport(const IoUringTransport&) = delete;
+    IoUringTransport& operator=(const IoUringTransport&) = delete;
+
+    // Open the device and attach it to the context (termios only if the context is not open)
+    ErrorCode configure(uint32_t baudRate) override;
+    size_t available() override;
+    int readByte() override;
+    size_t read(uint8_t* buffer, size_t length) override;
+    bool writeByte(uint8_t byte) override;
+    size_t write(const uint8_t* data, size_t length) override;
+    ErrorCode waitReadable(uint32_t timeoutUs) override;
+
+    // Detach from the context and close the device
+    void close();
+
+    // File descriptor of the open device (-1 if closed)
+    int getFd() const { return m_serial.getFd(); }
+
+private:
+    friend class IoUringContext;
+
+    static constexpr size_t NO_SLOT = static_cast<size_t>(-1);
+
+    IoUringContext& m_context;                  // Shared io_uring instance
+    PosixSerialTransport m_serial;              // Device (opened and configured with termios)
+    size_t m_slot;                              // Context slot (NO_SLOT when not attached)
+    SpscRingBuffer<RX_BUFFER_SIZE> m_rxBuffer;  // Received bytes not read yet
+};
+
+} // namespace IOLink
+
+#endif // IOLINK_PLATFORM_POSIX && IOLINK_USE_IO_URING
+
+#endif // IOLINK_IO_URING_H
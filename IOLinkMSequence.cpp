@@ -0,0 +1,132 @@
+/**
+ * @file IOLinkMSequence.cpp
+ * @brief IO-Link M-sequence codec implementation
+ */
+
+#include "IOLinkMSequence.h"
+#include "IOLinkChecksum.h"
+#include <string.h>
+
+namespace IOLink {
+
+namespace {
+
+// MC octet
+constexpr uint8_t MC_READ = 0x80;
+constexpr uint8_t MC_CHANNEL_SHIFT = 5;
+constexpr uint8_t MC_CHANNEL_MASK = 0x03;
+constexpr uint8_t MC_ADDRESS_MASK = 0x1F;
+
+// CKT octet
+constexpr uint8_t CKT_TYPE_SHIFT = 6;
+
+// CKS octet
+constexpr uint8_t CKS_EVENT = 0x80;
+constexpr uint8_t CKS_PD_INVALID = 0x40;
+
+// Checksum bits of the CKT and CKS octets
+constexpr uint8_t CHECKSUM_MASK = 0x3F;
+
+} // namespace
+
+uint8_t mSequenceChecksum(const uint8_t* data, size_t length) {
+    return MSEQ_CHECKSUM_TABLE[xorChecksum(data, length, MSEQ_CHECKSUM_SEED)];
+}
+
+size_t encodeMasterMessage(const MSequenceConfig& config, const MasterMessage& message, uint8_t* buffer, size_t bufferSize) {
+    size_t length = config.masterLength(message.read);
+    if (bufferSize < length || message.address > MC_ADDRESS_MASK) {
+        return 0;
+    }
+
+    buffer[0] = (message.read ? MC_READ : 0) |
+                (static_cast<uint8_t>(message.channel) << MC_CHANNEL_SHIFT) |
+                message.address;
+    buffer[1] = static_cast<uint8_t>(config.type) << CKT_TYPE_SHIFT;
+
+    uint8_t* out = buffer + 2;
+    if (config.pdOutLength > 0) {
+        memcpy(out, message.pdOut, config.pdOutLength);
+        out += config.pdOutLength;
+    }
+    if (!message.read && config.odLength > 0) {
+        memcpy(out, message.od, config.odLength);
+    }
+
+    buffer[1] |= mSequenceChecksum(buffer, length);
+    return length;
+}
+
+ErrorCode decodeDeviceMessage(const MSequenceConfig& config, bool read, const uint8_t* data, size_t length, DeviceMessage& message) {
+    if (length != config.deviceLength(read)) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+
+    // Verify checksum over the message with the CKS checksum bits cleared
+    uint8_t cks = data[length - 1];
+    uint8_t ck8 = xorChecksum(data, length - 1, MSEQ_CHECKSUM_SEED) ^ (cks & ~CHECKSUM_MASK);
+    if (MSEQ_CHECKSUM_TABLE[ck8] != (cks & CHECKSUM_MASK)) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+
+    const uint8_t* in = data;
+    message.od = nullptr;
+    if (read && config.odLength > 0) {
+        message.od = in;
+        in += config.odLength;
+    }
+    message.pdIn = (config.pdInLength > 0) ? in : nullptr;
+    message.eventFlag = (cks & CKS_EVENT) != 0;
+    message.pdValid = (cks & CKS_PD_INVALID) == 0;
+
+    return ErrorCode::NONE;
+}
+
+ErrorCode decodeMasterMessage(const MSequenceConfig& config, const uint8_t* data, size_t length, MasterMessage& message) {
+    if (length < 2) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+
+    bool read = (data[0] & MC_READ) != 0;
+    if (length != config.masterLength(read) ||
+        (data[1] >> CKT_TYPE_SHIFT) != static_cast<uint8_t>(config.type)) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+
+    // Verify checksum over the message with the CKT checksum bits cleared
+    uint8_t ck8 = xorChecksum(data, length, MSEQ_CHECKSUM_SEED) ^ (data[1] & CHECKSUM_MASK);
+    if (MSEQ_CHECKSUM_TABLE[ck8] != (data[1] & CHECKSUM_MASK)) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+
+    message.read = read;
+    message.channel = static_cast<Channel>((data[0] >> MC_CHANNEL_SHIFT) & MC_CHANNEL_MASK);
+    message.address = data[0] & MC_ADDRESS_MASK;
+    message.pdOut = (config.pdOutLength > 0) ? data + 2 : nullptr;
+    message.od = (!read && config.odLength > 0) ? data + 2 + config.pdOutLength : nullptr;
+
+    return ErrorCode::NONE;
+}
+
+size_t encodeDeviceMessage(const MSequenceConfig& config, bool read, const DeviceMessage& message, uint8_t* buffer, size_t bufferSize) {
+    size_t length = config.deviceLength(read);
+    if (bufferSize < length) {
+        return 0;
+    }
+
+    uint8_t* out = buffer;
+    if (read && config.odLength > 0) {
+        memcpy(out, message.od, config.odLength);
+        out += config.odLength;
+    }
+    if (config.pdInLength > 0) {
+        memcpy(out, message.pdIn, config.pdInLength);
+        out += config.pdInLength;
+    }
+
+    *out = (message.eventFlag ? CKS_EVENT : 0) | (message.pdValid ? 0 : CKS_PD_INVALID);
+    *out |= mSequenceChecksum(buffer, length);
+    return length;
+}
+
+} // namespace IOLink
@@ -0,0 +1,169 @@
+/**
+ * @file IOLinkMSequence.h
+ * @brief IO-Link M-sequence codec (IEC 61131-9)
+ *
+ * Encodes and decodes the master and device messages of M-sequence
+ * types 0, 1_x and 2_x, including the MC, CKT and CKS octets and their
+ * 6-bit checksum. This is the framing real devices use on the wire; it
+ * can be selected on the master instead of the simple 0xA5 framing
+ * (see IOLinkMaster::setFraming()).
+ *
+ * Master message: [MC] [CKT] [PDout...] [OD... (write only)]
+ * Device message: [OD... (read only)] [PDin...] [CKS]
+ */
+
+#ifndef IOLINK_MSEQUENCE_H
+#define IOLINK_MSEQUENCE_H
+
+#include "IOLinkTypes.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <array>
+
+namespace IOLink {
+
+/**
+ * @enum MSequenceType
+ * @brief M-sequence type coded in the CKT octet
+ */
+enum class MSequenceType : uint8_t {
+    TYPE_0 = 0,     // On-request data only (1 octet)
+    TYPE_1 = 1,     // On-request data, no separate process data (1_1, 1_2, 1_V)
+    TYPE_2 = 2      // Process data plus on-request data (2_1 ... 2_V)
+};
+
+/**
+ * @enum Channel
+ * @brief Communication channel coded in the MC octet
+ */
+enum class Channel : uint8_t {
+    PROCESS = 0,    // Process data
+    PAGE = 1,       // Direct parameter page
+    DIAGNOSIS = 2,  // Events
+    ISDU = 3        // Indexed service data units
+};
+
+/**
+ * @struct MSequenceConfig
+ * @brief Octet layout of an M-sequence type
+ */
+struct MSequenceConfig {
+    MSequenceType type;     // Type coded in CKT
+    uint8_t odLength;       // On-request data octets
+    uint8_t pdInLength;     // Process data octets from the device
+    uint8_t pdOutLength;    // Process data octets to the device
+
+    // Length of the master message (OD is only sent for writes)
+    constexpr size_t masterLength(bool read) const {
+        return 2 + pdOutLength + (read ? 0 : odLength);
+    }
+
+    // Length of the device message (OD is only sent for reads)
+    constexpr size_t deviceLength(bool read) const {
+        return (read ? odLength : 0) + pdInLength + 1;
+    }
+
+    // Octet counts within the limits of the variable types
+    constexpr bool isValid() const;
+};
+
+// Predefined M-sequence types
+constexpr MSequenceConfig MSEQ_TYPE_0   = { MSequenceType::TYPE_0, 1, 0, 0 };
+constexpr MSequenceConfig MSEQ_TYPE_1_1 = { MSequenceType::TYPE_1, 2, 0, 0 };
+constexpr MSequenceConfig MSEQ_TYPE_1_2 = { MSequenceType::TYPE_1, 2, 0, 0 };
+constexpr MSequenceConfig MSEQ_TYPE_2_1 = { MSequenceType::TYPE_2, 1, 1, 0 };
+constexpr MSequenceConfig MSEQ_TYPE_2_2 = { MSequenceType::TYPE_2, 1, 2, 0 };
+constexpr MSequenceConfig MSEQ_TYPE_2_3 = { MSequenceType::TYPE_2, 1, 0, 1 };
+constexpr MSequenceConfig MSEQ_TYPE_2_4 = { MSequenceType::TYPE_2, 1, 0, 2 };
+constexpr MSequenceConfig MSEQ_TYPE_2_5 = { MSequenceType::TYPE_2, 1, 1, 1 };
+
+// Variable types (1_V: 8 or 32 OD octets, 2_V: up to 32 PD octets each way;
+// check isValid() before using computed lengths)
+constexpr MSequenceConfig makeType1V(uint8_t odLength) {
+    return { MSequenceType::TYPE_1, odLength, 0, 0 };
+}
+
+constexpr MSequenceConfig makeType2V(uint8_t odLength, uint8_t pdInLength, uint8_t pdOutLength) {
+    return { MSequenceType::TYPE_2, odLength, pdInLength, pdOutLength };
+}
+
+// Limits of the variable types
+constexpr size_t MSEQ_MAX_OD_LENGTH = 32;
+constexpr size_t MSEQ_MAX_PD_LENGTH = 32;
+constexpr size_t MSEQ_MAX_LENGTH = 2 + MSEQ_MAX_PD_LENGTH + MSEQ_MAX_OD_LENGTH;
+
+constexpr bool MSequenceConfig::isValid() const {
+    return odLength <= MSEQ_MAX_OD_LENGTH && pdInLength <= MSEQ_MAX_PD_LENGTH && pdOutLength <= MSEQ_MAX_PD_LENGTH;
+}
+
+// Checksum seed value defined by the specification
+constexpr uint8_t MSEQ_CHECKSUM_SEED = 0x52;
+
+/**
+ * @brief Compress an 8-bit XOR checksum into the 6-bit CKT/CKS checksum
+ *
+ * Bit-by-bit reference used to generate the lookup table below.
+ */
+constexpr uint8_t compressChecksum(uint8_t ck8) {
+    return static_cast<uint8_t>(
+        ((((ck8 >> 7) ^ (ck8 >> 5) ^ (ck8 >> 3) ^ (ck8 >> 1)) & 1) << 5) |
+        ((((ck8 >> 6) ^ (ck8 >> 4) ^ (ck8 >> 2) ^ ck8) & 1) << 4) |
+        ((((ck8 >> 7) ^ (ck8 >> 6)) & 1) << 3) |
+        ((((ck8 >> 5) ^ (ck8 >> 4)) & 1) << 2) |
+        ((((ck8 >> 3) ^ (ck8 >> 2)) & 1) << 1) |
+        (((ck8 >> 1) ^ ck8) & 1));
+}
+
+// Build the 8-bit to 6-bit compression table at compile time
+constexpr std::array<uint8_t, 256> makeChecksumTable() {
+    std::array<uint8_t, 256> table{};
+    for (size_t i = 0; i < table.size(); i++) {
+        table[i] = compressChecksum(static_cast<uint8_t>(i));
+    }
+    return table;
+}
+
+// 8-bit to 6-bit checksum compression table
+constexpr std::array<uint8_t, 256> MSEQ_CHECKSUM_TABLE = makeChecksumTable();
+
+/**
+ * @brief Compute the 6-bit checksum of an M-sequence message
+ *
+ * The checksum bits of the CKT/CKS octet must be zero in data.
+ */
+uint8_t mSequenceChecksum(const uint8_t* data, size_t length);
+
+/**
+ * @struct MasterMessage
+ * @brief Decoded (or to be encoded) master message
+ */
+struct MasterMessage {
+    bool read;                  // Read (true) or write (false) access
+    Channel channel;            // Communication channel
+    uint8_t address;            // Address within the channel (0-31)
+    const uint8_t* pdOut;       // Process data output (pdOutLength octets)
+    const uint8_t* od;          // On-request data (odLength octets, writes only)
+};
+
+/**
+ * @struct DeviceMessage
+ * @brief Decoded (or to be encoded) device message
+ */
+struct DeviceMessage {
+    const uint8_t* od;          // On-request data (odLength octets, reads only)
+    const uint8_t* pdIn;        // Process data input (pdInLength octets)
+    bool eventFlag;             // Device has pending events
+    bool pdValid;               // Process data input is valid
+};
+
+// Master side: encode a request and decode the device reply
+size_t encodeMasterMessage(const MSequenceConfig& config, const MasterMessage& message, uint8_t* buffer, size_t bufferSize);
+ErrorCode decodeDeviceMessage(const MSequenceConfig& config, bool read, const uint8_t* data, size_t length, DeviceMessage& message);
+
+// Device side: decode a request and encode the reply (used by simulators)
+ErrorCode decodeMasterMessage(const MSequenceConfig& config, const uint8_t* data, size_t length, MasterMessage& message);
+size_t encodeDeviceMessage(const MSequenceConfig& config, bool read, const DeviceMessage& message, uint8_t* buffer, size_t bufferSize);
+
+} // namespace IOLink
+
+#endif // IOLINK_MSEQUENCE_H
@@ -0,0 +1,353 @@
+/**
+ * @file IOLinkPosix.cpp
+ * @brief Transport and clock backends for Linux hosts
+ */
+
+#include "IOLinkPosix.h"
+
+#if defined(IOLINK_PLATFORM_POSIX)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace IOLink {
+
+namespace {
+
+// Map a baud rate to a termios speed constant
+bool toSpeed(uint32_t baudRate, speed_t& speed) {
+    switch (baudRate) {
+        case 4800: speed = B4800; return true;        // COM1
+        case 9600: speed = B9600; return true;
+        case 19200: speed = B19200; return true;
+        case 38400: speed = B38400; return true;      // COM2
+        case 57600: speed = B57600; return true;
+        case 115200: speed = B115200; return true;
+        case 230400: speed = B230400; return true;    // COM3
+        default: return false;
+    }
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+// PosixSerialTransport Implementation
+//-----------------------------------------------------------------------------
+
+PosixSerialTransport::PosixSerialTransport(const char* devicePath)
+    : m_devicePath(devicePath)
+    , m_fd(-1) {
+}
+
+PosixSerialTransport::~PosixSerialTransport() {
+    close();
+}
+
+ErrorCode PosixSerialTransport::configure(uint32_t baudRate) {
+    speed_t speed;
+    if (!toSpeed(baudRate, speed)) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+
+    if (m_fd < 0) {
+        m_fd = ::open(m_devicePath.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+        if (m_fd < 0) {
+            return ErrorCode::COMMUNICATION_ERROR;
+        }
+    }
+
+    // Raw mode, 8 data bits, even parity, 1 stop bit, no flow control
+    // (the IO-Link UART frame WireTiming is based on)
+    struct termios tio;
+    if (tcgetattr(m_fd, &tio) != 0) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag &= ~(PARODD | CSTOPB | CSIZE | CRTSCTS);
+    tio.c_cflag |= CS8 | PARENB | CLOCAL | CREAD;
+    tio.c_iflag &= ~(IXON | IXOFF | IXANY);
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+
+    if (tcsetattr(m_fd, TCSANOW, &tio) != 0) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+    tcflush(m_fd, TCIOFLUSH);
+
+    return ErrorCode::NONE;
+}
+
+size_t PosixSerialTransport::available() {
+    int count = 0;
+    if (m_fd < 0 || ioctl(m_fd, FIONREAD, &count) != 0 || count < 0) {
+        return 0;
+    }
+    return static_cast<size_t>(count);
+}
+
+int PosixSerialTransport::readByte() {
+    uint8_t byte;
+    if (read(&byte, 1) != 1) {
+        return -1;
+    }
+    return byte;
+}
+
+size_t PosixSerialTransport::read(uint8_t* buffer, size_t length) {
+    if (m_fd < 0 || length == 0) {
+        return 0;
+    }
+
+    ssize_t count;
+    do {
+        count = ::read(m_fd, buffer, length);
+    } while (count < 0 && errno == EINTR);
+    return count > 0 ? static_cast<size_t>(count) : 0;
+}
+
+bool PosixSerialTransport::writeByte(uint8_t byte) {
+    return write(&byte, 1) == 1;
+}
+
+size_t PosixSerialTransport::write(const uint8_t* data, size_t length) {
+    if (m_fd < 0) {
+        return 0;
+    }
+
+    // Normally completes with a single write() call
+    size_t count = 0;
+    while (count < length) {
+        ssize_t written = ::write(m_fd, data + count, length - count);
+        if (written > 0) {
+            count += static_cast<size_t>(written);
+            continue;
+        }
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written < 0 && errno != EAGAIN) {
+            break;
+        }
+
+        // Output buffer full, wait until the device accepts more data
+        struct pollfd pfd = { m_fd, POLLOUT, 0 };
+        if (poll(&pfd, 1, -1) < 0 && errno != EINTR) {
+            break;
+        }
+    }
+    return count;
+}
+
+ErrorCode PosixSerialTransport::waitReadable(uint32_t timeoutUs) {
+    if (m_fd < 0) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+
+    // ppoll() takes a timespec, so waits are not rounded up to milliseconds
+    struct pollfd pfd = { m_fd, POLLIN, 0 };
+    struct timespec timeout;
+    timeout.tv_sec = timeoutUs / 1000000;
+    timeout.tv_nsec = static_cast<long>(timeoutUs % 1000000) * 1000L;
+
+    int result = ppoll(&pfd, 1, &timeout, nullptr);
+    if (result > 0 && (pfd.revents & POLLIN)) {
+        return ErrorCode::NONE;
+    }
+    if (result == 0 || (result < 0 && errno == EINTR)) {
+        return ErrorCode::TIMEOUT;
+    }
+    return ErrorCode::COMMUNICATION_ERROR;
+}
+
+void PosixSerialTransport::close() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// ThreadedSerialTransport Implementation
+//-----------------------------------------------------------------------------
+
+constexpr size_t ThreadedSerialTransport::RX_BUFFER_SIZE;
+
+ThreadedSerialTransport::ThreadedSerialTransport(const char* devicePath)
+    : m_serial(devicePath)
+    , m_running(false)
+    , m_wakeFd(-1)
+    , m_waiting(false) {
+}
+
+ThreadedSerialTransport::~ThreadedSerialTransport() {
+    close();
+}
+
+ErrorCode ThreadedSerialTransport::configure(uint32_t baudRate) {
+    // Reconfigure with the reader stopped, the device flushes its input
+    stop();
+
+    ErrorCode result = m_serial.configure(baudRate);
+    if (result != ErrorCode::NONE) {
+        return result;
+    }
+
+    m_wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_wakeFd < 0) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+
+    m_rxBuffer.reset();
+    m_running.store(true, std::memory_order_release);
+    m_reader = std::thread(&ThreadedSerialTransport::run, this);
+    return ErrorCode::NONE;
+}
+
+size_t ThreadedSerialTransport::available() {
+    return m_rxBuffer.size();
+}
+
+int ThreadedSerialTransport::readByte() {
+    return m_rxBuffer.pop();
+}
+
+size_t ThreadedSerialTransport::read(uint8_t* buffer, size_t length) {
+    return m_rxBuffer.pop(buffer, length);
+}
+
+bool ThreadedSerialTransport::writeByte(uint8_t byte) {
+    return m_serial.writeByte(byte);
+}
+
+size_t ThreadedSerialTransport::write(const uint8_t* data, size_t length) {
+    return m_serial.write(data, length);
+}
+
+ErrorCode ThreadedSerialTransport::waitReadable(uint32_t timeoutUs) {
+    if (!m_rxBuffer.empty()) {
+        return ErrorCode::NONE;
+    }
+
+    // The reader thread only takes the lock to notify while someone waits
+    std::unique_lock<std::mutex> lock(m_waitMutex);
+    m_waiting.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool ready = m_readable.wait_for(lock, std::chrono::microseconds(timeoutUs), [this]() {
+        return !m_rxBuffer.empty();
+    });
+    m_waiting.store(false, std::memory_order_relaxed);
+
+    return ready ? ErrorCode::NONE : ErrorCode::TIMEOUT;
+}
+
+void ThreadedSerialTransport::close() {
+    stop();
+    m_serial.close();
+}
+
+void ThreadedSerialTransport::stop() {
+    if (m_reader.joinable()) {
+        m_running.store(false, std::memory_order_release);
+        uint64_t wake = 1;
+        ssize_t written = ::write(m_wakeFd, &wake, sizeof(wake));
+        (void)written;
+        m_reader.join();
+    }
+    if (m_wakeFd >= 0) {
+        ::close(m_wakeFd);
+        m_wakeFd = -1;
+    }
+}
+
+void ThreadedSerialTransport::run() {
+    struct pollfd pfds[2] = {
+        { m_serial.getFd(), POLLIN, 0 },
+        { m_wakeFd, POLLIN, 0 }
+    };
+
+    while (m_running.load(std::memory_order_acquire)) {
+        size_t space;
+        uint8_t* buffer = m_rxBuffer.writeBuffer(space);
+        if (space == 0) {
+            // Ring full: leave the bytes in the kernel until the consumer catches up
+            struct timespec pause = { 0, 100000 };
+            nanosleep(&pause, nullptr);
+            continue;
+        }
+
+        if (poll(pfds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (pfds[1].revents != 0) {
+            break;
+        }
+        if ((pfds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) && !(pfds[0].revents & POLLIN)) {
+            // Device gone (e.g. USB adapter unplugged)
+            break;
+        }
+
+        // Receive directly into the ring
+        size_t count = m_serial.read(buffer, space);
+        if (count > 0) {
+            m_rxBuffer.commit(count);
+
+            // Wake the consumer if it is blocked in waitReadable()
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_waiting.load()) {
+                std::lock_guard<std::mutex> lock(m_waitMutex);
+                m_readable.notify_one();
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// PosixClock Implementation
+//-----------------------------------------------------------------------------
+
+uint32_t PosixClock::milliseconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint32_t>(now.tv_sec * 1000ULL + now.tv_nsec / 1000000);
+}
+
+uint64_t PosixClock::microseconds() {
+    return nanoseconds() / 1000;
+}
+
+uint64_t PosixClock::nanoseconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+void PosixClock::delayMilliseconds(uint32_t ms) {
+    struct timespec duration;
+    duration.tv_sec = ms / 1000;
+    duration.tv_nsec = static_cast<long>(ms % 1000) * 1000000L;
+    while (nanosleep(&duration, &duration) != 0 && errno == EINTR) {
+    }
+}
+
+void PosixClock::delayMicroseconds(uint32_t us) {
+    struct timespec duration;
+    duration.tv_sec = us / 1000000;
+    duration.tv_nsec = static_cast<long>(us % 1000000) * 1000L;
+    while (nanosleep(&duration, &duration) != 0 && errno == EINTR) {
+    }
+}
+
+} // namespace IOLink
+
+#endif // IOLINK_PLATFORM_POSIX
@@ -0,0 +1,122 @@
+/**
+ * @file IOLinkPosix.h
+ * @brief Transport and clock backends for Linux hosts
+ *
+ * Lets the IO-Link master run on a Linux gateway with USB-serial
+ * IO-Link PHYs (e.g. /dev/ttyUSB0) instead of a ClearCore serial port.
+ */
+
+#ifndef IOLINK_POSIX_H
+#define IOLINK_POSIX_H
+
+#include "IOLinkConfig.h"
+
+#if defined(IOLINK_PLATFORM_POSIX)
+
+#include "IOLinkTransport.h"
+#include "IOLinkRingBuffer.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace IOLink {
+
+/**
+ * @class PosixSerialTransport
+ * @brief Transport over a termios serial device
+ */
+class PosixSerialTransport : public Transport {
+public:
+    // Constructor with the path of the serial device (opened by configure())
+    explicit PosixSerialTransport(const char* devicePath);
+    ~PosixSerialTransport() override;
+
+    PosixSerialTransport(const PosixSerialTransport&) = delete;
+    PosixSerialTransport& operator=(const PosixSerialTransport&) = delete;
+
+    ErrorCode configure(uint32_t baudRate) override;
+    size_t available() override;
+    int readByte() override;
+    size_t read(uint8_t* buffer, size_t length) override;
+    bool writeByte(uint8_t byte) override;
+    size_t write(const uint8_t* data, size_t length) override;
+    ErrorCode waitReadable(uint32_t timeoutUs) override;
+
+    // Close the device
+    void close();
+
+    // File descriptor of the open device (-1 if closed)
+    int getFd() const { return m_fd; }
+
+private:
+    std::string m_devicePath;   // Path of the serial device
+    int m_fd;                   // File descriptor of the open device
+};
+
+/**
+ * @class ThreadedSerialTransport
+ * @brief Serial transport with a dedicated reader thread
+ *
+ * The reader thread blocks in poll() on the device and moves received
+ * bytes into a lock-free ring as soon as they arrive; the protocol
+ * thread reads from the ring without system calls. Transmission goes
+ * directly to the device from the calling thread.
+ */
+class ThreadedSerialTransport : public Transport {
+public:
+    static constexpr size_t RX_BUFFER_SIZE = 4096;  // Receive ring capacity (power of two)
+
+    // Constructor with the path of the serial device (opened by configure())
+    explicit ThreadedSerialTransport(const char* devicePath);
+    ~ThreadedSerialTransport() override;
+
+    ThreadedSerialTransport(const ThreadedSerialTransport&) = delete;
+    ThreadedSerialTransport& operator=(const ThreadedSerialTransport&) = delete;
+
+    // Open the device and start the reader thread
+    ErrorCode configure(uint32_t baudRate) override;
+    size_t available() override;
+    int readByte() override;
+    size_t read(uint8_t* buffer, size_t length) override;
+    bool writeByte(uint8_t byte) override;
+    size_t write(const uint8_t* data, size_t length) override;
+    ErrorCode waitReadable(uint32_t timeoutUs) override;
+
+    // Stop the reader thread and close the device
+    void close();
+
+private:
+    PosixSerialTransport m_serial;                  // Underlying device
+    SpscRingBuffer<RX_BUFFER_SIZE> m_rxBuffer;      // Bytes handed from the reader thread
+    std::thread m_reader;                           // Reader thread
+    std::atomic<bool> m_running;                    // Reader thread keeps running while set
+    int m_wakeFd;                                   // eventfd that interrupts the reader's poll()
+    std::mutex m_waitMutex;                         // Protects waiting for received data
+    std::condition_variable m_readable;             // Signalled when data arrives for a waiter
+    std::atomic<bool> m_waiting;                    // Consumer is blocked in waitReadable()
+
+    // Reader thread body
+    void run();
+    void stop();
+};
+
+/**
+ * @class PosixClock
+ * @brief Clock based on CLOCK_MONOTONIC
+ */
+class PosixClock : public Clock {
+public:
+    uint32_t milliseconds() override;
+    uint64_t microseconds() override;
+    uint64_t nanoseconds() override;
+    void delayMilliseconds(uint32_t ms) override;
+    void delayMicroseconds(uint32_t us) override;
+};
+
+} // namespace IOLink
+
+#endif // IOLINK_PLATFORM_POSIX
+
+#endif // IOLINK_POSIX_H
@@ -0,0 +1,168 @@
+/**
+ * @file IOLinkRingBuffer.h
+ * @brief Lock-free single-producer/single-consumer byte ring
+ *
+ * Hands received bytes from the context that reads the UART (an
+ * interrupt handler on the MCU, a reader thread on Linux) to the context
+ * running the protocol. Exactly one producer and one consumer may use a
+ * ring concurrently; neither side ever blocks or waits for the other.
+ */
+
+#ifndef IOLINK_RING_BUFFER_H
+#define IOLINK_RING_BUFFER_H
+
+#include "IOLinkConfig.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+namespace IOLink {
+
+/**
+ * @class SpscRingBuffer
+ * @brief Wait-free SPSC byte ring with power-of-two capacity
+ *
+ * The read and write indices run freely and are masked on access, so
+ * all Capacity bytes are usable. Each index sits on its own cache line
+ * together with the owner's cached copy of the other index, which keeps
+ * the two sides from sharing a line except when the cache is refreshed.
+ */
+template <size_t Capacity>
+class SpscRingBuffer {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Ring capacity must be a power of two");
+
+public:
+    SpscRingBuffer()
+        : m_head(0)
+        , m_tailCache(0)
+        , m_tail(0)
+        , m_headCache(0) {
+    }
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    static constexpr size_t capacity() { return Capacity; }
+
+    //-------------------------------------------------------------------------
+    // Producer side
+    //-------------------------------------------------------------------------
+
+    // Append bytes (returns the number stored, less than length when full)
+    size_t push(const uint8_t* data, size_t length) {
+        size_t stored = 0;
+        while (stored < length) {
+            size_t space;
+            uint8_t* buffer = writeBuffer(space);
+            if (space == 0) {
+                break;
+            }
+            if (space > length - stored) {
+                space = length - stored;
+            }
+            memcpy(buffer, data + stored, space);
+            commit(space);
+            stored += space;
+        }
+        return stored;
+    }
+
+    bool push(uint8_t byte) {
+        return push(&byte, 1) == 1;
+    }
+
+    // In-place write: get the contiguous free area (up to the wrap point),
+    // fill it (e.g. with read()) and commit the number of bytes stored
+    uint8_t* writeBuffer(size_t& space) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t offset = head & MASK;
+        size_t contiguous = Capacity - offset;
+
+        // Only look at the consumer's index when the cached one limits the area
+        if (Capacity - (head - m_tailCache) < contiguous) {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+        }
+
+        space = Capacity - (head - m_tailCache);
+        if (space > contiguous) {
+            space = contiguous;
+        }
+        return m_buffer + offset;
+    }
+
+    void commit(size_t count) {
+        m_head.store(m_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // Free space as seen by the producer
+    size_t space() {
+        m_tailCache = m_tail.load(std::memory_order_acquire);
+        return Capacity - (m_head.load(std::memory_order_relaxed) - m_tailCache);
+    }
+
+    //-------------------------------------------------------------------------
+    // Consumer side
+    //-------------------------------------------------------------------------
+
+    // Remove up to length bytes (returns the number copied)
+    size_t pop(uint8_t* buffer, size_t length) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (m_headCache - tail < length) {
+            m_headCache = m_head.load(std::memory_order_acquire);
+        }
+
+        size_t count = m_headCache - tail;
+        if (count > length) {
+            count = length;
+        }
+
+        // Copy in up to two parts around the wrap point
+        size_t offset = tail & MASK;
+        size_t first = Capacity - offset;
+        if (first > count) {
+            first = count;
+        }
+        memcpy(buffer, m_buffer + offset, first);
+        memcpy(buffer + first, m_buffer, count - first);
+
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    int pop() {
+        uint8_t byte;
+        return pop(&byte, 1) == 1 ? byte : -1;
+    }
+
+    // Number of stored bytes as seen by the consumer
+    size_t size() {
+        m_headCache = m_head.load(std::memory_order_acquire);
+        return m_headCache - m_tail.load(std::memory_order_relaxed);
+    }
+
+    bool empty() { return size() == 0; }
+
+    //-------------------------------------------------------------------------
+
+    // Discard all bytes (only while neither side is using the ring)
+    void reset() {
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+        m_tailCache = 0;
+        m_headCache = 0;
+    }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    alignas(IOLINK_CACHE_LINE_SIZE) std::atomic<size_t> m_head;    // Write index (producer)
+    size_t m_tailCache;                                             // Producer's copy of the read index
+    alignas(IOLINK_CACHE_LINE_SIZE) std::atomic<size_t> m_tail;    // Read index (consumer)
+    size_t m_headCache;                                             // Consumer's copy of the write index
+    alignas(IOLINK_CACHE_LINE_SIZE) uint8_t m_buffer[Capacity];    // Stored bytes
+};
+
+} // namespace IOLink
+
+#endif // IOLINK_RING_BUFFER_H
@@ -0,0 +1,345 @@
+/**
+ * @file IOLinkSimulator.cpp
+ * @brief Pseudo-terminal IO-Link device simulator implementation
+ */
+
+#include "IOLinkSimulator.h"
+
+#if defined(IOLINK_PLATFORM_POSIX)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace IOLink {
+
+namespace {
+
+// Monotonic time in nanoseconds
+uint64_t nowNs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+// Map a termios speed constant to a baud rate (0 if not an IO-Link rate)
+uint32_t fromSpeed(speed_t speed) {
+    switch (speed) {
+        case B4800: return 4800;        // COM1
+        case B9600: return 9600;
+        case B19200: return 19200;
+        case B38400: return 38400;      // COM2
+        case B57600: return 57600;
+        case B115200: return 115200;
+        case B230400: return 230400;    // COM3
+        default: return 0;
+    }
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+// SimulatedDevice Implementation
+//-----------------------------------------------------------------------------
+
+SimulatedDevice::SimulatedDevice(size_t processDataInLength)
+    : m_processDataInLength(processDataInLength < MAX_PAYLOAD_LENGTH ? processDataInLength : MAX_PAYLOAD_LENGTH)
+    , m_processDataOutLength(0)
+    , m_frameCount(0) {
+    memset(m_processDataIn, 0, sizeof(m_processDataIn));
+}
+
+void SimulatedDevice::setProcessDataIn(const uint8_t* data, size_t length) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_processDataInLength = (length < MAX_PAYLOAD_LENGTH) ? length : MAX_PAYLOAD_LENGTH;
+    memcpy(m_processDataIn, data, m_processDataInLength);
+}
+
+size_t SimulatedDevice::getProcessDataOut(uint8_t* buffer, size_t bufferSize) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t length = (m_processDataOutLength < bufferSize) ? m_processDataOutLength : bufferSize;
+    memcpy(buffer, m_processDataOut, length);
+    return m_processDataOutLength;
+}
+
+bool SimulatedDevice::onFrame(const FrameView& request, MessageType& replyType, uint8_t* reply, size_t& replyLength) {
+    if (request.type != MessageType::PROCESS_DATA) {
+        // No other services by default
+        return false;
+    }
+
+    // Exchange process data: keep the outputs, answer with the inputs
+    std::lock_guard<std::mutex> lock(m_mutex);
+    memcpy(m_processDataOut, request.data, request.length);
+    m_processDataOutLength = request.length;
+
+    replyType = MessageType::PROCESS_DATA;
+    memcpy(reply, m_processDataIn, m_processDataInLength);
+    replyLength = m_processDataInLength;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// DeviceSimulator Implementation
+//-----------------------------------------------------------------------------
+
+DeviceSimulator::DeviceSimulator()
+    : m_baudRate(0)
+    , m_responseDelayBits(MAX_RESPONSE_DELAY_BITS)
+    , m_pacing(true)
+    , m_wakeFd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+    , m_running(false) {
+}
+
+DeviceSimulator::~DeviceSimulator() {
+    stop();
+    for (auto& port : m_ports) {
+        close(port->fd);
+        close(port->slaveFd);
+    }
+    if (m_wakeFd >= 0) {
+        close(m_wakeFd);
+    }
+}
+
+ErrorCode DeviceSimulator::addDevice(SimulatedDevice& device, size_t& index) {
+    if (m_running.load(std::memory_order_acquire)) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+
+    std::unique_ptr<Port> port(new Port());
+    port->device = &device;
+    port->fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (port->fd < 0) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+    if (grantpt(port->fd) != 0 || unlockpt(port->fd) != 0 ||
+        ptsname_r(port->fd, port->path, sizeof(port->path)) != 0) {
+        close(port->fd);
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+
+    // Without an open slave side the terminal hangs up whenever the
+    // master closes its transport, so the simulator holds one open. It
+    // also starts the terminal in raw mode (no echo, no line editing).
+    port->slaveFd = open(port->path, O_RDWR | O_NOCTTY | O_CLOEXEC);
+    struct termios tio;
+    if (port->slaveFd < 0 || tcgetattr(port->slaveFd, &tio) != 0) {
+        if (port->slaveFd >= 0) {
+            close(port->slaveFd);
+        }
+        close(port->fd);
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+    cfmakeraw(&tio);
+    tcsetattr(port->slaveFd, TCSANOW, &tio);
+
+    port->rxWireEnd = 0;
+    port->txHead = 0;
+    port->txNext = 0;
+    updateTiming(*port);
+
+    index = m_ports.size();
+    m_ports.push_back(std::move(port));
+    return ErrorCode::NONE;
+}
+
+const char* DeviceSimulator::getDevicePath(size_t index) const {
+    return (index < m_ports.size()) ? m_ports[index]->path : nullptr;
+}
+
+ErrorCode DeviceSimulator::sendEvent(size_t index, const uint8_t* data, size_t length) {
+    if (index >= m_ports.size() || length > MAX_PAYLOAD_LENGTH) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_eventMutex);
+        m_pendingEvents.push_back(PendingEvent{index, std::vector<uint8_t>(data, data + length)});
+    }
+
+    uint64_t value = 1;
+    ssize_t result = write(m_wakeFd, &value, sizeof(value));
+    (void)result;
+    return ErrorCode::NONE;
+}
+
+void DeviceSimulator::runOnce(uint32_t timeoutUs) {
+    // Sleep no longer than until the next octet is due
+    uint64_t now = nowNs();
+    uint64_t waitNs = timeoutUs * 1000ULL;
+    for (auto& port : m_ports) {
+        if (port->txHead < port->txQueue.size()) {
+            uint64_t due = (port->txNext > now) ? port->txNext - now : 0;
+            if (due < waitNs) {
+                waitNs = due;
+            }
+        }
+    }
+
+    std::vector<struct pollfd> fds(m_ports.size() + 1);
+    fds[0].fd = m_wakeFd;
+    fds[0].events = POLLIN;
+    for (size_t i = 0; i < m_ports.size(); i++) {
+        fds[i + 1].fd = m_ports[i]->fd;
+        fds[i + 1].events = POLLIN;
+    }
+
+    struct timespec timeout;
+    timeout.tv_sec = waitNs / 1000000000ULL;
+    timeout.tv_nsec = static_cast<long>(waitNs % 1000000000ULL);
+    if (ppoll(fds.data(), fds.size(), &timeout, nullptr) < 0 && errno != EINTR) {
+        return;
+    }
+    now = nowNs();
+
+    if (fds[0].revents & POLLIN) {
+        uint64_t value;
+        ssize_t result = read(m_wakeFd, &value, sizeof(value));
+        (void)result;
+
+        std::vector<PendingEvent> events;
+        {
+            std::lock_guard<std::mutex> lock(m_eventMutex);
+            events.swap(m_pendingEvents);
+        }
+        for (const PendingEvent& event : events) {
+            queueFrame(*m_ports[event.index], MessageType::EVENT, event.data.data(), event.data.size(), now);
+        }
+    }
+
+    for (size_t i = 0; i < m_ports.size(); i++) {
+        if (fds[i + 1].revents & POLLIN) {
+            receive(*m_ports[i], now);
+        }
+        release(*m_ports[i], nowNs());
+    }
+}
+
+ErrorCode DeviceSimulator::start() {
+    if (m_wakeFd < 0) {
+        return ErrorCode::COMMUNICATION_ERROR;
+    }
+    if (m_running.exchange(true, std::memory_order_acq_rel)) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+
+    m_thread = std::thread(&DeviceSimulator::run, this);
+    return ErrorCode::NONE;
+}
+
+void DeviceSimulator::stop() {
+    if (!m_running.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    uint64_t value = 1;
+    ssize_t result = write(m_wakeFd, &value, sizeof(value));
+    (void)result;
+    m_thread.join();
+}
+
+void DeviceSimulator::updateTiming(Port& port) {
+    // Follow the baud rate the master configured on its side of the terminal
+    uint32_t baudRate = m_baudRate;
+    struct termios tio;
+    if (baudRate == 0 && tcgetattr(port.slaveFd, &tio) == 0) {
+        baudRate = fromSpeed(cfgetospeed(&tio));
+    }
+
+    WireTiming timing(baudRate);
+    port.octetNs = m_pacing ? timing.transmitNs(1) : 0;
+    port.responseDelayNs = m_pacing ? timing.bitsNs(m_responseDelayBits) : 0;
+}
+
+void DeviceSimulator::receive(Port& port, uint64_t now) {
+    updateTiming(port);
+
+    while (true) {
+        size_t space;
+        uint8_t* buffer = port.decoder.writeBuffer(space);
+        ssize_t count = read(port.fd, buffer, space);
+        if (count <= 0) {
+            break;
+        }
+        port.decoder.commit(static_cast<size_t>(count));
+
+        // The pseudo-terminal delivers at once what takes wire time on a real link
+        if (port.rxWireEnd < now) {
+            port.rxWireEnd = now;
+        }
+        port.rxWireEnd += count * port.octetNs;
+
+        while (port.decoder.next()) {
+            port.device->m_frameCount.fetch_add(1, std::memory_order_relaxed);
+
+            MessageType replyType;
+            uint8_t reply[MAX_PAYLOAD_LENGTH];
+            size_t replyLength = 0;
+            if (port.device->onFrame(port.decoder.getFrame(), replyType, reply, replyLength)) {
+                queueFrame(port, replyType, reply, replyLength, port.rxWireEnd + port.responseDelayNs);
+            }
+        }
+    }
+}
+
+void DeviceSimulator::queueFrame(Port& port, MessageType type, const uint8_t* payload, size_t length, uint64_t start) {
+    uint8_t frame[MAX_FRAME_LENGTH];
+    size_t frameLength = encodeFrame(type, payload, length, frame, sizeof(frame));
+    if (frameLength == 0) {
+        return;
+    }
+
+    // A frame queued behind others follows them back to back
+    if (port.txHead == port.txQueue.size()) {
+        port.txQueue.clear();
+        port.txHead = 0;
+        port.txNext = start + port.octetNs;
+    }
+    port.txQueue.insert(port.txQueue.end(), frame, frame + frameLength);
+}
+
+void DeviceSimulator::release(Port& port, uint64_t now) {
+    size_t queued = port.txQueue.size() - port.txHead;
+    if (queued == 0 || now < port.txNext) {
+        return;
+    }
+
+    // Octets whose UART frame has been completed by now
+    size_t count = queued;
+    if (port.octetNs > 0) {
+        uint64_t due = (now - port.txNext) / port.octetNs + 1;
+        if (due < count) {
+            count = static_cast<size_t>(due);
+        }
+    }
+
+    ssize_t written = write(port.fd, port.txQueue.data() + port.txHead, count);
+    if (written <= 0) {
+        return;
+    }
+    port.txHead += static_cast<size_t>(written);
+    port.txNext += written * port.octetNs;
+
+    if (port.txHead == port.txQueue.size()) {
+        port.txQueue.clear();
+        port.txHead = 0;
+    }
+}
+
+void DeviceSimulator::run() {
+    while (m_running.load(std::memory_order_acquire)) {
+        runOnce(100000);
+    }
+}
+
+} // namespace IOLink
+
+#endif // IOLINK_PLATFORM_POSIX
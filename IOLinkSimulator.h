@@ -0,0 +1,176 @@
+/**
+ * @file IOLinkSimulator.h
+ * @brief Pseudo-terminal IO-Link device simulator for Linux hosts
+ *
+ * Runs IOLinkMaster against simulated devices without IO-Link hardware.
+ * Each simulated device sits behind a pseudo-terminal; the master opens
+ * the terminal's device path with the ordinary PosixSerialTransport (or
+ * any other Linux transport), so the code under test is unchanged.
+ *
+ * The simulator works at the frame level ([0xA5] [TYPE] [LENGTH]
+ * [PAYLOAD] [XOR]) and keeps wire time: a request counts as received
+ * when its last octet would have left the wire at the port's baud rate,
+ * the reply starts after the device response delay and its octets are
+ * released one UART frame time apart. Cycle times and throughput
+ * measured against the simulator therefore match those of real COM1,
+ * COM2 or COM3 links, not those of the (instant) pseudo-terminal.
+ */
+
+#ifndef IOLINK_SIMULATOR_H
+#define IOLINK_SIMULATOR_H
+
+#include "IOLinkConfig.h"
+
+#if defined(IOLINK_PLATFORM_POSIX)
+
+#include "IOLinkTypes.h"
+#include "IOLinkFrame.h"
+#include "IOLinkTiming.h"
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace IOLink {
+
+/**
+ * @class SimulatedDevice
+ * @brief Frame-level behaviour of a simulated IO-Link device
+ *
+ * The default device answers every process data frame with its input
+ * process data and keeps the output process data it received. Derive
+ * from it and override onFrame() to emulate other behaviour (parameter
+ * access, errors, slow or missing replies).
+ *
+ * The process data accessors may be called from any thread.
+ */
+class SimulatedDevice {
+public:
+    // Constructor with the initial input process data length (zero-filled)
+    explicit SimulatedDevice(size_t processDataInLength = 2);
+    virtual ~SimulatedDevice() = default;
+
+    // Input process data sent to the master
+    void setProcessDataIn(const uint8_t* data, size_t length);
+
+    // Last output process data received from the master (returns its length)
+    size_t getProcessDataOut(uint8_t* buffer, size_t bufferSize) const;
+
+    // Number of frames received from the master
+    uint32_t getFrameCount() const { return m_frameCount.load(std::memory_order_relaxed); }
+
+    // Handle a frame from the master. Returns true and fills in the reply
+    // (at most MAX_PAYLOAD_LENGTH payload octets) to answer it, false to
+    // stay silent. Called from the simulator thread.
+    virtual bool onFrame(const FrameView& request, MessageType& replyType, uint8_t* reply, size_t& replyLength);
+
+private:
+    friend class DeviceSimulator;
+
+    mutable std::mutex m_mutex;                     // Guards the process data
+    uint8_t m_processDataIn[MAX_PAYLOAD_LENGTH];    // Input process data
+    size_t m_processDataInLength;                   // Input process data length
+    uint8_t m_processDataOut[MAX_PAYLOAD_LENGTH];   // Last output process data
+    size_t m_processDataOutLength;                  // Last output process data length
+    std::atomic<uint32_t> m_frameCount;             // Frames received
+};
+
+/**
+ * @class DeviceSimulator
+ * @brief Serves simulated devices on pseudo-terminals
+ *
+ * Add the devices, then either start() the simulator thread or call
+ * runOnce() from your own loop. Devices must be added before the
+ * simulator runs.
+ */
+class DeviceSimulator {
+public:
+    DeviceSimulator();
+    ~DeviceSimulator();
+
+    DeviceSimulator(const DeviceSimulator&) = delete;
+    DeviceSimulator& operator=(const DeviceSimulator&) = delete;
+
+    // Create a pseudo-terminal for the device (index receives the device number)
+    ErrorCode addDevice(SimulatedDevice& device, size_t& index);
+    size_t getDeviceCount() const { return m_ports.size(); }
+
+    // Path the master opens to talk to the device (e.g. "/dev/pts/3")
+    const char* getDevicePath(size_t index) const;
+
+    // Baud rate used for pacing (0 = follow the baud rate the master
+    // configured on the terminal, the default)
+    void setBaudRate(uint32_t baudRate) { m_baudRate = baudRate; }
+
+    // Delay between the end of a request and the start of the reply, in bit times
+    void setResponseDelay(uint32_t bits) { m_responseDelayBits = bits; }
+
+    // Release octets at wire speed (true, the default) or as fast as possible
+    void setPacing(bool enable) { m_pacing = enable; }
+
+    // Queue an event frame from a device (may be called from any thread)
+    ErrorCode sendEvent(size_t index, const uint8_t* data, size_t length);
+
+    // Serve the devices for up to timeoutUs (returns after the first
+    // batch of work, so call it in a loop)
+    void runOnce(uint32_t timeoutUs);
+
+    // Serve the devices from a background thread
+    ErrorCode start();
+    void stop();
+
+private:
+    // Simulated device port
+    struct Port {
+        SimulatedDevice* device;        // Device behind the terminal
+        int fd;                         // Master side of the pseudo-terminal
+        int slaveFd;                    // Slave side, kept open so the terminal persists
+        char path[64];                  // Slave device path
+        FrameDecoder decoder;           // Frames received from the master
+        uint64_t octetNs;               // Wire time of one octet (0 = no pacing)
+        uint64_t responseDelayNs;       // Device response delay
+        uint64_t rxWireEnd;             // Time the last received octet left the wire (ns)
+        std::vector<uint8_t> txQueue;   // Octets not yet released to the master
+        size_t txHead;                  // First unreleased octet in txQueue
+        uint64_t txNext;                // Release time of the next octet (ns)
+    };
+
+    // Event queued by sendEvent()
+    struct PendingEvent {
+        size_t index;                   // Device number
+        std::vector<uint8_t> data;      // Event payload
+    };
+
+    std::vector<std::unique_ptr<Port>> m_ports;     // Device ports
+    uint32_t m_baudRate;                            // Pacing baud rate (0 = from termios)
+    uint32_t m_responseDelayBits;                   // Device response delay (bit times)
+    bool m_pacing;                                  // Release octets at wire speed
+    int m_wakeFd;                                   // eventfd waking the simulator loop
+    std::mutex m_eventMutex;                        // Guards m_pendingEvents
+    std::vector<PendingEvent> m_pendingEvents;      // Events not yet queued on their port
+    std::atomic<bool> m_running;                    // Background thread keeps running while set
+    std::thread m_thread;                           // Background thread
+
+    // Pick up the baud rate of a port
+    void updateTiming(Port& port);
+
+    // Decode the frames the master sent and queue the device replies
+    void receive(Port& port, uint64_t now);
+
+    // Queue a frame whose first octet starts at the given time (ns)
+    void queueFrame(Port& port, MessageType type, const uint8_t* payload, size_t length, uint64_t start);
+
+    // Write the queued octets that are due to the master
+    void release(Port& port, uint64_t now);
+
+    // Background thread
+    void run();
+};
+
+} // namespace IOLink
+
+#endif // IOLINK_PLATFORM_POSIX
+
+#endif // IOLINK_SIMULATOR_H
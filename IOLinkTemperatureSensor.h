@@ -67,3 +67,5 @@ private:
 };
 
 } // namespace IOLink
+
+#endif // IOLINK_TEMPERATURE_SENSOR_H
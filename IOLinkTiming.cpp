@@ -0,0 +1,47 @@
+/**
+ * @file IOLinkTiming.cpp
+ * @brief Cycle scheduler implementation
+ */
+
+#include "IOLinkTiming.h"
+
+namespace IOLink {
+
+//-----------------------------------------------------------------------------
+// CycleScheduler Implementation
+//-----------------------------------------------------------------------------
+
+CycleScheduler::CycleScheduler(Clock& clock, uint64_t periodNs)
+    : m_clock(clock)
+    , m_periodNs(periodNs)
+    , m_cycleEnd(clock, periodNs)
+    , m_overruns(0) {
+}
+
+void CycleScheduler::start() {
+    m_cycleEnd = Deadline(m_clock, m_periodNs);
+    m_overruns = 0;
+}
+
+uint32_t CycleScheduler::waitNextCycle() {
+    uint32_t remaining = m_cycleEnd.remainingMicroseconds();
+    if (remaining > 0) {
+        m_clock.delayMicroseconds(remaining);
+    }
+
+    // The next cycle starts where this one ends, not where the wait returned
+    m_cycleEnd.extend(m_periodNs);
+
+    uint64_t now = m_clock.nanoseconds();
+    if (m_periodNs == 0 || now < m_cycleEnd.getExpiry()) {
+        return 0;
+    }
+
+    // Overrun: skip the cycles that already ended
+    uint64_t skipped = (now - m_cycleEnd.getExpiry()) / m_periodNs + 1;
+    m_cycleEnd.extend(skipped * m_periodNs);
+    m_overruns += skipped;
+    return static_cast<uint32_t>(skipped);
+}
+
+} // namespace IOLink
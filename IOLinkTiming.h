@@ -0,0 +1,136 @@
+/**
+ * @file IOLinkTiming.h
+ * @brief Wire timing model of IO-Link communication (IEC 61131-9)
+ *
+ * Every octet on the IO-Link wire is a UART frame of 11 bits (start bit,
+ * 8 data bits, even parity, stop bit). From the baud rate of the port
+ * (COM1/COM2/COM3) and the frame sizes, WireTiming computes how long a
+ * master message takes to send, how long the device may take to answer
+ * and how long a complete cycle lasts, using the worst-case gaps and
+ * response delay the standard allows. Receive timeouts and the cycle
+ * period are derived from it instead of fixed guesses.
+ */
+
+#ifndef IOLINK_TIMING_H
+#define IOLINK_TIMING_H
+
+#include "IOLinkTypes.h"
+#include "IOLinkTransport.h"
+#include <stddef.h>
+#include <stdint.h>
+
+namespace IOLink {
+
+// Baud rates of the COM modes
+constexpr uint32_t COM1_BAUD_RATE = 4800;
+constexpr uint32_t COM2_BAUD_RATE = 38400;
+constexpr uint32_t COM3_BAUD_RATE = 230400;
+
+// UART frame and timing limits in bit times
+constexpr uint32_t UART_FRAME_BITS = 11;            // Start, 8 data, parity and stop bit per octet
+constexpr uint32_t MAX_MASTER_GAP_BITS = 1;         // t1: gap between octets of a master message
+constexpr uint32_t MAX_DEVICE_GAP_BITS = 3;         // t2: gap between octets of a device message
+constexpr uint32_t MAX_RESPONSE_DELAY_BITS = 10;    // tA: end of master message to start of reply
+
+// Baud rate of a COM mode (0 for SIO)
+constexpr uint32_t baudRateOf(OperationMode mode) {
+    return (mode == OperationMode::COM1) ? COM1_BAUD_RATE :
+           (mode == OperationMode::COM2) ? COM2_BAUD_RATE :
+           (mode == OperationMode::COM3) ? COM3_BAUD_RATE : 0;
+}
+
+/**
+ * @class WireTiming
+ * @brief Duration of messages and cycles at a baud rate
+ *
+ * All durations are in nanoseconds (the time base of Deadline) and are
+ * rounded up, so they are never shorter than the time on the wire.
+ */
+class WireTiming {
+public:
+    // Timing at the given baud rate (0 selects COM1, the slowest rate)
+    constexpr explicit WireTiming(uint32_t baudRate = COM1_BAUD_RATE)
+        : m_baudRate(baudRate > 0 ? baudRate : COM1_BAUD_RATE) {}
+
+    constexpr uint32_t getBaudRate() const { return m_baudRate; }
+
+    // Duration of a number of bit times
+    constexpr uint64_t bitsNs(uint64_t bits) const {
+        return (bits * 1000000000ULL + m_baudRate - 1) / m_baudRate;
+    }
+
+    // Octets sent back to back
+    constexpr uint64_t transmitNs(size_t octets) const {
+        return bitsNs(octets * UART_FRAME_BITS);
+    }
+
+    // Master message including the worst-case gaps between its octets
+    constexpr uint64_t masterMessageNs(size_t octets) const {
+        return bitsNs(octets * UART_FRAME_BITS + gapBits(octets, MAX_MASTER_GAP_BITS));
+    }
+
+    // End of the master message to the end of the device reply: response
+    // delay plus the reply with the worst-case gaps between its octets
+    constexpr uint64_t deviceResponseNs(size_t octets) const {
+        return bitsNs(MAX_RESPONSE_DELAY_BITS + octets * UART_FRAME_BITS + gapBits(octets, MAX_DEVICE_GAP_BITS));
+    }
+
+    // Complete cycle: master message followed by the device reply
+    constexpr uint64_t cycleNs(size_t requestOctets, size_t responseOctets) const {
+        return bitsNs(octetBits(requestOctets, MAX_MASTER_GAP_BITS) + MAX_RESPONSE_DELAY_BITS +
+                      octetBits(responseOctets, MAX_DEVICE_GAP_BITS));
+    }
+
+private:
+    uint32_t m_baudRate;    // Baud rate
+
+    static constexpr uint64_t gapBits(size_t octets, uint32_t gap) {
+        return (octets > 1) ? (octets - 1) * gap : 0;
+    }
+
+    static constexpr uint64_t octetBits(size_t octets, uint32_t gap) {
+        return octets * UART_FRAME_BITS + gapBits(octets, gap);
+    }
+};
+
+/**
+ * @class CycleScheduler
+ * @brief Paces a cyclic exchange on absolute cycle deadlines
+ *
+ * Each cycle starts exactly one period after the previous one, no matter
+ * how long the work inside the cycle took, so the cycle does not drift.
+ * The period is typically IOLinkMaster::getCycleTime(), i.e. the wire
+ * time of the exchange rather than a conservative guess.
+ */
+class CycleScheduler {
+public:
+    // Scheduler with the clock and the cycle period
+    CycleScheduler(Clock& clock, uint64_t periodNs);
+
+    void setPeriod(uint64_t periodNs) { m_periodNs = periodNs; }
+    uint64_t getPeriod() const { return m_periodNs; }
+
+    // Start the first cycle now
+    void start();
+
+    // End of the current cycle (e.g. as deadline for the cycle's replies)
+    const Deadline& getCycleEnd() const { return m_cycleEnd; }
+
+    // Sleep until the current cycle ends and start the next one. When the
+    // cycle overran, the missed cycles are skipped instead of being run
+    // back to back (returns the number of cycles skipped).
+    uint32_t waitNextCycle();
+
+    // Number of cycles skipped since start()
+    uint64_t getOverrunCount() const { return m_overruns; }
+
+private:
+    Clock& m_clock;         // Clock of the cycle deadlines
+    uint64_t m_periodNs;    // Cycle period
+    Deadline m_cycleEnd;    // End of the current cycle
+    uint64_t m_overruns;    // Cycles skipped
+};
+
+} // namespace IOLink
+
+#endif // IOLINK_TIMING_H
@@ -0,0 +1,174 @@
+/**
+ * @file IOLinkTransaction.cpp
+ * @brief Pipelined request/reply transactions implementation
+ */
+
+#include "IOLinkTransaction.h"
+#include <utility>
+
+namespace IOLink {
+
+//-----------------------------------------------------------------------------
+// TransactionManager Implementation
+//-----------------------------------------------------------------------------
+
+TransactionManager::TransactionManager(IOLinkMaster& master)
+    : m_master(master)
+    , m_pending(0)
+    , m_waitSliceUs(1000) {
+}
+
+ErrorCode TransactionManager::submit(uint8_t port, MessageType type, const uint8_t* data, size_t length,
+                                     TransactionCallback callback, uint32_t timeout) {
+    if (port >= m_master.getPortCount() || length > MAX_PAYLOAD_LENGTH) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    if (m_queues.size() < m_master.getPortCount()) {
+        m_queues.resize(m_master.getPortCount());
+    }
+
+    Transaction transaction;
+    transaction.type = type;
+    transaction.request.assign(data, data + length);
+    transaction.callback = std::move(callback);
+    transaction.timeout = timeout;
+    transaction.sent = false;
+
+    m_queues[port].push_back(std::move(transaction));
+    m_pending++;
+
+    // An idle port sends right away, a busy one when its reply arrives
+    if (m_queues[port].size() == 1) {
+        send(port);
+    }
+    return ErrorCode::NONE;
+}
+
+size_t TransactionManager::poll() {
+    // Queued frames of all ports go out together
+    m_master.flush();
+
+    size_t completed = 0;
+    Deadline now(m_master.getClock(), 0);
+    for (size_t index = 0; index < m_queues.size(); index++) {
+        uint8_t port = static_cast<uint8_t>(index);
+        if (m_queues[index].empty() || !m_queues[index].front().sent) {
+            continue;
+        }
+
+        // Take the reply if it is there, never wait
+        Transaction& transaction = m_queues[index].front();
+        FrameView reply;
+        ErrorCode result = m_master.receiveMessage(port, transaction.type, reply, now);
+        if (result == ErrorCode::NONE) {
+            complete(port, ErrorCode::NONE, reply);
+            completed++;
+        } else if (result != ErrorCode::TIMEOUT) {
+            complete(port, result, FrameView{transaction.type, nullptr, 0});
+            completed++;
+        } else if (transaction.deadline.isExpired()) {
+            complete(port, ErrorCode::TIMEOUT, FrameView{transaction.type, nullptr, 0});
+            completed++;
+        }
+    }
+    return completed;
+}
+
+size_t TransactionManager::run(const Deadline& deadline) {
+    size_t completed = 0;
+    while (m_pending > 0) {
+        size_t count = poll();
+        completed += count;
+        if (m_pending == 0 || deadline.isExpired()) {
+            break;
+        }
+        if (count > 0) {
+            continue;
+        }
+
+        // Nothing arrived: block on the port whose transaction expires
+        // first, for no longer than a slice, so replies on other ports
+        // are picked up soon after they arrive
+        size_t first = m_queues.size();
+        for (size_t index = 0; index < m_queues.size(); index++) {
+            if (!m_queues[index].empty() && m_queues[index].front().sent &&
+                (first == m_queues.size() ||
+                 m_queues[index].front().deadline.getExpiry() < m_queues[first].front().deadline.getExpiry())) {
+                first = index;
+            }
+        }
+        if (first == m_queues.size()) {
+            break;
+        }
+
+        Transaction& transaction = m_queues[first].front();
+        Deadline wait = Deadline::fromMicroseconds(m_master.getClock(), m_waitSliceUs);
+        if (transaction.deadline.getExpiry() < wait.getExpiry()) {
+            wait = transaction.deadline;
+        }
+        if (deadline.getExpiry() < wait.getExpiry()) {
+            wait = deadline;
+        }
+
+        FrameView reply;
+        uint8_t port = static_cast<uint8_t>(first);
+        if (m_master.receiveMessage(port, transaction.type, reply, wait) == ErrorCode::NONE) {
+            complete(port, ErrorCode::NONE, reply);
+            completed++;
+        }
+    }
+    return completed;
+}
+
+Deadline TransactionManager::getDeadline(uint8_t port) const {
+    if (port >= m_queues.size() || m_queues[port].empty() || !m_queues[port].front().sent) {
+        return Deadline();
+    }
+    return m_queues[port].front().deadline;
+}
+
+bool TransactionManager::isPending(uint8_t port, MessageType type) const {
+    if (port >= m_queues.size()) {
+        return false;
+    }
+    for (const Transaction& transaction : m_queues[port]) {
+        if (transaction.type == type) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TransactionManager::send(uint8_t port) {
+    Transaction& transaction = m_queues[port].front();
+
+    // The timeout runs from the moment the request leaves, not from submit()
+    if (transaction.timeout == IOLinkMaster::AUTO_TIMEOUT) {
+        transaction.deadline = m_master.responseDeadline(FRAME_OVERHEAD + transaction.request.size(), MAX_FRAME_LENGTH);
+    } else {
+        transaction.deadline = Deadline::fromMilliseconds(m_master.getClock(), transaction.timeout);
+    }
+    transaction.sent = true;
+
+    ErrorCode result = m_master.sendMessage(port, transaction.type, transaction.request.data(), transaction.request.size());
+    if (result != ErrorCode::NONE) {
+        complete(port, result, FrameView{transaction.type, nullptr, 0});
+    }
+}
+
+void TransactionManager::complete(uint8_t port, ErrorCode result, const FrameView& reply) {
+    std::deque<Transaction>& queue = m_queues[port];
+    TransactionCallback callback = std::move(queue.front().callback);
+    queue.pop_front();
+    m_pending--;
+
+    // The callback may submit further transactions (and grow m_queues)
+    if (callback) {
+        callback(port, result, reply);
+    }
+    if (!m_queues[port].empty() && !m_queues[port].front().sent) {
+        send(port);
+    }
+}
+
+} // namespace IOLink
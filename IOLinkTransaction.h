@@ -0,0 +1,100 @@
+/**
+ * @file IOLinkTransaction.h
+ * @brief Pipelined request/reply transactions across master ports
+ *
+ * IOLinkMaster::sendMessage() followed by receiveMessage() waits for
+ * each reply before the next port is served, so a cycle over N ports
+ * takes N round trips. The TransactionManager sends the requests of all
+ * ports back to back and completes each transaction when its reply
+ * arrives, so a cycle over independent ports takes about as long as the
+ * slowest single round trip.
+ */
+
+#ifndef IOLINK_TRANSACTION_H
+#define IOLINK_TRANSACTION_H
+
+#include "IOLink.h"
+#include <stdint.h>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace IOLink {
+
+// Callback invoked when a transaction completes (result is NONE with the
+// reply, or TIMEOUT / COMMUNICATION_ERROR with an empty reply); the reply
+// references the receive buffer and is only valid during the call
+using TransactionCallback = std::function<void(uint8_t port, ErrorCode result, const FrameView& reply)>;
+
+/**
+ * @class TransactionManager
+ * @brief Issues requests to many ports and completes them as replies arrive
+ *
+ * Each port has one transaction in flight; further transactions
+ * submitted for the port wait in its queue and are sent as soon as the
+ * one before them completes. The reply is the next frame of the
+ * request's message type received on the port.
+ *
+ * Not thread-safe: submit, poll and run from the thread using the master.
+ */
+class TransactionManager {
+public:
+    // Constructor with the master whose ports carry the transactions
+    explicit TransactionManager(IOLinkMaster& master);
+
+    // Queue a request. The timeout starts when the request is sent;
+    // AUTO_TIMEOUT allows the wire time of the request and of the longest
+    // possible reply (a reply that arrives earlier completes earlier).
+    ErrorCode submit(uint8_t port, MessageType type, const uint8_t* data, size_t length,
+                     TransactionCallback callback, uint32_t timeout = IOLinkMaster::AUTO_TIMEOUT);
+
+    // Send pending requests and complete the transactions whose reply
+    // has arrived or whose deadline has passed, without waiting
+    // (returns the number of transactions completed)
+    size_t poll();
+
+    // Poll until every transaction has completed or the deadline expires
+    // (returns the number of transactions completed)
+    size_t run(const Deadline& deadline = Deadline());
+
+    // Longest time run() blocks on one port while others may have
+    // completed (default 1 ms)
+    void setWaitSlice(uint32_t sliceUs) { m_waitSliceUs = sliceUs; }
+
+    // Number of transactions submitted and not completed yet
+    size_t getPendingCount() const { return m_pending; }
+
+    // Reply deadline of the transaction in flight on a port (a deadline
+    // that never expires if no request of the port is on the wire)
+    Deadline getDeadline(uint8_t port) const;
+
+    // Check whether transactions of a type are queued or in flight on a
+    // port (their replies are the next frames of that type)
+    bool isPending(uint8_t port, MessageType type) const;
+
+private:
+    // Queued or in-flight transaction
+    struct Transaction {
+        MessageType type;               // Request and reply type
+        std::vector<uint8_t> request;   // Request payload
+        TransactionCallback callback;   // Completion callback
+        uint32_t timeout;               // Timeout in ms (or AUTO_TIMEOUT)
+        bool sent;                      // Request is on the wire
+        Deadline deadline;              // Reply deadline (valid once sent)
+    };
+
+    IOLinkMaster& m_master;                                 // Master carrying the transactions
+    std::vector<std::deque<Transaction>> m_queues;          // Transactions per port (front is in flight)
+    size_t m_pending;                                       // Transactions not completed
+    uint32_t m_waitSliceUs;                                 // Longest blocking wait on one port
+
+    // Send the request at the front of a port queue
+    void send(uint8_t port);
+
+    // Complete the transaction in flight on a port and send the next one
+    void complete(uint8_t port, ErrorCode result, const FrameView& reply);
+};
+
+} // namespace IOLink
+
+#endif // IOLINK_TRANSACTION_H
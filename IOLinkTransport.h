@@ -0,0 +1,170 @@
+/**
+ * @file IOLinkTransport.h
+ * @brief Transport and clock interfaces used by the IO-Link master
+ *
+ * The master only talks to the physical layer and the system timer
+ * through these interfaces, so the protocol core runs unchanged on the
+ * ClearCore (IOLinkClearCore.h) and on Linux hosts (IOLinkPosix.h).
+ */
+
+#ifndef IOLINK_TRANSPORT_H
+#define IOLINK_TRANSPORT_H
+
+#include "IOLinkTypes.h"
+#include <stddef.h>
+#include <stdint.h>
+
+namespace IOLink {
+
+/**
+ * @class Transport
+ * @brief Byte stream to one IO-Link port (UART of an IO-Link PHY)
+ */
+class Transport {
+public:
+    virtual ~Transport() = default;
+
+    // Open the port with the given baud rate (8 data bits, even parity, 1 stop bit)
+    virtual ErrorCode configure(uint32_t baudRate) = 0;
+
+    // Number of received bytes ready to be read
+    virtual size_t available() = 0;
+
+    // Read one received byte (returns -1 if none is available)
+    virtual int readByte() = 0;
+
+    // Read up to length received bytes without blocking (returns the number read)
+    // Backends should override this with a single bulk read; the default
+    // falls back to readByte()
+    virtual size_t read(uint8_t* buffer, size_t length) {
+        size_t count = 0;
+        while (count < length && available() > 0) {
+            int byte = readByte();
+            if (byte < 0) {
+                break;
+            }
+            buffer[count++] = static_cast<uint8_t>(byte);
+        }
+        return count;
+    }
+
+    // Send one byte
+    virtual bool writeByte(uint8_t byte) = 0;
+
+    // Send a block of bytes (returns the number of bytes sent)
+    // Backends should override this with a single bulk write; the default
+    // falls back to writeByte()
+    virtual size_t write(const uint8_t* data, size_t length) {
+        size_t count = 0;
+        while (count < length && writeByte(data[count])) {
+            count++;
+        }
+        return count;
+    }
+
+    // Block until received data is available (NONE) or timeoutUs expires
+    // (TIMEOUT); may return early. Backends that cannot wait return
+    // NOT_SUPPORTED and the master sleeps between polls instead.
+    virtual ErrorCode waitReadable(uint32_t timeoutUs) {
+        (void)timeoutUs;
+        return ErrorCode::NOT_SUPPORTED;
+    }
+};
+
+/**
+ * @class Clock
+ * @brief Time source used for timeouts
+ */
+class Clock {
+public:
+    virtual ~Clock() = default;
+
+    // Monotonic time in milliseconds (may wrap around)
+    virtual uint32_t milliseconds() = 0;
+
+    // Monotonic time in microseconds (clocks without a finer time base
+    // fall back to milliseconds)
+    virtual uint64_t microseconds() { return milliseconds() * 1000ULL; }
+
+    // Monotonic time in nanoseconds, the time base of deadlines (clocks
+    // without a finer time base fall back to microseconds)
+    virtual uint64_t nanoseconds() { return microseconds() * 1000ULL; }
+
+    // Sleep (or yield) for the given number of milliseconds
+    virtual void delayMilliseconds(uint32_t ms) = 0;
+
+    // Sleep for the given number of microseconds (rounded up to whole
+    // milliseconds by clocks that cannot sleep shorter)
+    virtual void delayMicroseconds(uint32_t us) { delayMilliseconds((us + 999) / 1000); }
+};
+
+/**
+ * @class Deadline
+ * @brief Absolute point in time on a Clock
+ *
+ * A deadline is fixed once when an operation starts, so repeated waits
+ * within the operation cannot stretch it, and a periodic deadline that
+ * is advanced with extend() does not drift.
+ */
+class Deadline {
+public:
+    // Expiry of a deadline that never expires
+    static constexpr uint64_t NEVER = UINT64_MAX;
+
+    // Deadline that never expires
+    Deadline() : m_clock(nullptr), m_expiry(NEVER) {}
+
+    // Deadline timeoutNs nanoseconds from now
+    Deadline(Clock& clock, uint64_t timeoutNs) : m_clock(&clock), m_expiry(clock.nanoseconds() + timeoutNs) {}
+
+    static Deadline fromMilliseconds(Clock& clock, uint32_t ms) { return Deadline(clock, ms * 1000000ULL); }
+    static Deadline fromMicroseconds(Clock& clock, uint32_t us) { return Deadline(clock, us * 1000ULL); }
+
+    // Deadline at a time on the clock's nanosecond time base
+    static Deadline at(Clock& clock, uint64_t expiryNs) {
+        Deadline deadline;
+        deadline.m_clock = &clock;
+        deadline.m_expiry = expiryNs;
+        return deadline;
+    }
+
+    // Expiry on the clock's nanosecond time base
+    uint64_t getExpiry() const { return m_expiry; }
+
+    bool isExpired() const {
+        return m_clock != nullptr && m_expiry != NEVER && m_clock->nanoseconds() >= m_expiry;
+    }
+
+    // Time left (0 once expired)
+    uint64_t remainingNanoseconds() const {
+        if (m_clock == nullptr || m_expiry == NEVER) {
+            return NEVER;
+        }
+        uint64_t now = m_clock->nanoseconds();
+        return (now < m_expiry) ? m_expiry - now : 0;
+    }
+
+    // Time left rounded up to whole microseconds (saturates at UINT32_MAX)
+    uint32_t remainingMicroseconds() const {
+        uint64_t remaining = remainingNanoseconds();
+        if (remaining >= UINT32_MAX * 1000ULL) {
+            return UINT32_MAX;
+        }
+        return static_cast<uint32_t>((remaining + 999) / 1000);
+    }
+
+    // Move the deadline later (e.g. by one cycle period)
+    void extend(uint64_t ns) {
+        if (m_expiry != NEVER) {
+            m_expiry += ns;
+        }
+    }
+
+private:
+    Clock* m_clock;         // Clock the deadline refers to (nullptr = never expires)
+    uint64_t m_expiry;      // Expiry in nanoseconds
+};
+
+} // namespace IOLink
+
+#endif // IOLINK_TRANSPORT_H
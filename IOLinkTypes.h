@@ -0,0 +1,50 @@
+/**
+ * @file IOLinkTypes.h
+ * @brief Common types shared by the IO-Link library components
+ */
+
+#ifndef IOLINK_TYPES_H
+#define IOLINK_TYPES_H
+
+#include <stdint.h>
+
+namespace IOLink {
+
+/**
+ * @enum ErrorCode
+ * @brief Result codes returned by IO-Link operations
+ */
+enum class ErrorCode {
+    NONE,                   // Operation completed successfully
+    COMMUNICATION_ERROR,    // Framing, checksum or transmission error
+    TIMEOUT,                // No (complete) response within the timeout
+    INVALID_PARAMETER,      // Invalid port, index or argument
+    NOT_SUPPORTED,          // Operation not supported by the device
+    DEVICE_ERROR            // Device reported an error
+};
+
+/**
+ * @enum OperationMode
+ * @brief IO-Link port operation modes
+ */
+enum class OperationMode {
+    SIO,        // Standard I/O mode (no IO-Link communication)
+    COM1,       // 4.8 kbaud
+    COM2,       // 38.4 kbaud
+    COM3        // 230.4 kbaud
+};
+
+/**
+ * @enum MessageType
+ * @brief Types of messages exchanged with IO-Link devices
+ */
+enum class MessageType {
+    PROCESS_DATA,   // Cyclic process data
+    PARAMETER,      // Acyclic parameter (on-request) data
+    DIAGNOSTIC,     // Diagnostic data
+    EVENT           // Device events
+};
+
+} // namespace IOLink
+
+#endif // IOLINK_TYPES_H
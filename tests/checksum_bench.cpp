@@ -0,0 +1,130 @@
+/**
+ * @file checksum_bench.cpp
+ * @brief XOR checksum kernel against the byte loop it replaced
+ *
+ * Times xorChecksum() and a plain byte loop for every payload length from
+ * 1 to 255 (the frame checksum covers the header as well, so a frame
+ * checks FRAME_OVERHEAD - 1 more octets), and the batch xorChecksums()
+ * against one call per buffer for groups of 16 frames.
+ */
+
+#include "IOLinkChecksum.h"
+#include "IOLinkFrame.h"
+#include <stdio.h>
+#include <chrono>
+#include <random>
+
+using namespace IOLink;
+
+namespace {
+
+using BenchClock = std::chrono::steady_clock;
+
+constexpr size_t LANES = 16;
+
+// The byte loop used before the vector kernels
+__attribute__((noinline)) uint8_t byteChecksum(const uint8_t* data, size_t length, uint8_t seed) {
+    uint8_t checksum = seed;
+    for (size_t i = 0; i < length; i++) {
+        checksum ^= data[i];
+    }
+    return checksum;
+}
+
+// Nanoseconds per call of function(data, length, seed)
+template <typename Function>
+double timeChecksum(Function function, const uint8_t* data, size_t length, size_t iterations) {
+    volatile uint8_t sink = 0;
+    uint8_t seed = 0;
+    auto start = BenchClock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        // Chaining the seed keeps the calls from being hoisted or merged
+        seed = function(data, length, seed);
+    }
+    auto elapsed = BenchClock::now() - start;
+    sink = seed;
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+// Best of a few runs (the least disturbed by other processes)
+template <typename Function>
+double bestOf(Function function, const uint8_t* data, size_t length, size_t iterations) {
+    double best = 0.0;
+    for (int run = 0; run < 5; run++) {
+        double ns = timeChecksum(function, data, length, iterations);
+        if (run == 0 || ns < best) {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 random(6);
+    alignas(64) uint8_t frames[LANES][MAX_FRAME_LENGTH];
+    for (auto& frame : frames) {
+        for (uint8_t& byte : frame) {
+            byte = static_cast<uint8_t>(random());
+        }
+    }
+
+    auto kernel = [](const uint8_t* data, size_t length, uint8_t seed) { return xorChecksum(data, length, seed); };
+
+    printf("%7s %12s %12s %8s\n", "length", "byte ns", "kernel ns", "speedup");
+    double byteTotal = 0.0;
+    double kernelTotal = 0.0;
+    for (size_t length = 1; length <= MAX_PAYLOAD_LENGTH; length++) {
+        // Odd offset: the payload of a frame follows the 3-octet header
+        const uint8_t* data = frames[0] + 3;
+        size_t iterations = 2000000 / (length + 16);
+        double byteNs = bestOf(byteChecksum, data, length, iterations);
+        double kernelNs = bestOf(kernel, data, length, iterations);
+        byteTotal += byteNs;
+        kernelTotal += kernelNs;
+        printf("%7zu %12.2f %12.2f %7.2fx\n", length, byteNs, kernelNs, byteNs / kernelNs);
+    }
+    printf("%7s %12.2f %12.2f %7.2fx\n", "mean", byteTotal / MAX_PAYLOAD_LENGTH, kernelTotal / MAX_PAYLOAD_LENGTH,
+           byteTotal / kernelTotal);
+
+    // Batch checksums of 16 frames against one call per frame
+    const uint8_t* data[LANES];
+    size_t lengths[LANES];
+    uint8_t results[LANES];
+    printf("\n%7s %12s %12s %8s\n", "frames", "single ns", "batch ns", "speedup");
+    const size_t batchLengths[] = {4, 8, 16, 32, 64, 128, MAX_FRAME_LENGTH};
+    for (size_t length : batchLengths) {
+        for (size_t k = 0; k < LANES; k++) {
+            data[k] = frames[k];
+            lengths[k] = length;
+        }
+
+        size_t iterations = 200000 / (length + 16);
+        double singleNs = 0.0;
+        double batchNs = 0.0;
+        for (int run = 0; run < 5; run++) {
+            volatile uint8_t sink = 0;
+            auto start = BenchClock::now();
+            for (size_t i = 0; i < iterations; i++) {
+                for (size_t k = 0; k < LANES; k++) {
+                    results[k] = xorChecksum(data[k], lengths[k]);
+                }
+                sink = sink ^ results[i % LANES];
+            }
+            double ns = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count() / iterations;
+            singleNs = (run == 0 || ns < singleNs) ? ns : singleNs;
+
+            start = BenchClock::now();
+            for (size_t i = 0; i < iterations; i++) {
+                xorChecksums(data, lengths, LANES, results);
+                sink = sink ^ results[i % LANES];
+            }
+            ns = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count() / iterations;
+            batchNs = (run == 0 || ns < batchNs) ? ns : batchNs;
+        }
+        printf("16x%-4zu %12.2f %12.2f %7.2fx\n", length, singleNs, batchNs, singleNs / batchNs);
+    }
+    return 0;
+}
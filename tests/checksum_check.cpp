@@ -0,0 +1,134 @@
+/**
+ * @file checksum_check.cpp
+ * @brief Exhaustive check of the XOR checksum kernels against a byte loop
+ *
+ * Every length from 0 to 255 at every alignment within a cache line,
+ * with several seeds, for xorChecksum(); the batch xorChecksums() (whose
+ * SSE2 path transposes 16 accumulators in foldLanes()) is checked for
+ * every length and alignment in full groups of 16 buffers and with
+ * mixed lengths and partial groups. The Makefile also builds this file
+ * with AVX2 and without any vector unit so every kernel is covered.
+ */
+
+#include "IOLinkChecksum.h"
+#include <stdio.h>
+#include <random>
+
+using namespace IOLink;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++;                                                         \
+        }                                                                       \
+    } while (0)
+
+constexpr size_t MAX_LENGTH = 255;
+constexpr size_t ALIGNMENTS = 64;
+constexpr size_t LANES = 16;
+
+// Reference: the byte loop the kernels replace
+uint8_t byteChecksum(const uint8_t* data, size_t length, uint8_t seed) {
+    uint8_t checksum = seed;
+    for (size_t i = 0; i < length; i++) {
+        checksum ^= data[i];
+    }
+    return checksum;
+}
+
+const char* kernelName() {
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "word";
+#endif
+}
+
+} // namespace
+
+int main() {
+#if defined(__AVX2__) && (defined(__x86_64__) || defined(__i386__))
+    if (!__builtin_cpu_supports("avx2")) {
+        printf("AVX2 not supported by this CPU, skipped\n");
+        return 0;
+    }
+#endif
+
+    std::mt19937 random(6);
+    alignas(64) uint8_t pool[LANES][ALIGNMENTS + MAX_LENGTH + 64];
+    for (auto& buffer : pool) {
+        for (uint8_t& byte : buffer) {
+            byte = static_cast<uint8_t>(random());
+        }
+    }
+
+    // xorChecksum(): every length, alignment and a few seeds
+    const uint8_t seeds[] = {0x00, 0x52, 0xFF};
+    size_t checked = 0;
+    for (size_t length = 0; length <= MAX_LENGTH; length++) {
+        for (size_t alignment = 0; alignment < ALIGNMENTS; alignment++) {
+            const uint8_t* data = pool[0] + alignment;
+            for (uint8_t seed : seeds) {
+                CHECK(xorChecksum(data, length, seed) == byteChecksum(data, length, seed));
+                checked++;
+            }
+        }
+    }
+
+    // A single flipped bit anywhere changes the checksum by that bit
+    uint8_t frame[MAX_LENGTH];
+    for (size_t i = 0; i < sizeof(frame); i++) {
+        frame[i] = static_cast<uint8_t>(random());
+    }
+    uint8_t reference = xorChecksum(frame, sizeof(frame));
+    for (size_t i = 0; i < sizeof(frame); i++) {
+        for (int bit = 0; bit < 8; bit++) {
+            frame[i] ^= static_cast<uint8_t>(1 << bit);
+            CHECK(xorChecksum(frame, sizeof(frame)) == (reference ^ (1 << bit)));
+            frame[i] ^= static_cast<uint8_t>(1 << bit);
+        }
+    }
+
+    // xorChecksums(): 16 buffers of one length, each at its own alignment
+    const uint8_t* data[3 * LANES + 5];
+    size_t lengths[3 * LANES + 5];
+    uint8_t results[3 * LANES + 5];
+    for (size_t length = 0; length <= MAX_LENGTH; length++) {
+        for (size_t alignment = 0; alignment < ALIGNMENTS; alignment += LANES) {
+            for (size_t k = 0; k < LANES; k++) {
+                data[k] = pool[k] + alignment + k;
+                lengths[k] = length;
+            }
+            xorChecksums(data, lengths, LANES, results);
+            for (size_t k = 0; k < LANES; k++) {
+                CHECK(results[k] == byteChecksum(data[k], length, 0));
+            }
+            checked += LANES;
+        }
+    }
+
+    // Mixed lengths, full and partial groups
+    for (size_t round = 0; round < 2000; round++) {
+        size_t count = random() % (sizeof(results) + 1);
+        for (size_t k = 0; k < count; k++) {
+            lengths[k] = random() % (MAX_LENGTH + 1);
+            data[k] = pool[k % LANES] + random() % ALIGNMENTS;
+        }
+        xorChecksums(data, lengths, count, results);
+        for (size_t k = 0; k < count; k++) {
+            CHECK(results[k] == byteChecksum(data[k], lengths[k], 0));
+        }
+        checked += count;
+    }
+
+    printf("%s kernel: %zu checksums compared\n", kernelName(), checked);
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
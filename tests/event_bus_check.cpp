@@ -0,0 +1,291 @@
+/**
+ * @file event_bus_check.cpp
+ * @brief EventBus routing against a naive filter match
+ *
+ * Random events are published to a bus with overlapping port, code
+ * range and severity filters; the handlers called, their order and the
+ * count publish() returns are compared with testing every filter in
+ * subscription order. Subscribers are added and removed between events
+ * and from inside handlers while an event is delivered: a handler added
+ * then must not get the current event, one removed must not get it if
+ * its turn has not come yet.
+ */
+
+#include "IOLinkEvent.h"
+#include <stdio.h>
+#include <random>
+#include <vector>
+
+using namespace IOLink;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++;                                                         \
+        }                                                                       \
+    } while (0)
+
+// Code range boundaries shared by the filters, so that ranges overlap
+// and events hit the edges
+const uint16_t BOUNDARIES[] = {0x0000, 0x1000, 0x1800, 0x4000, 0x5000, 0x8CA0, 0xFF00, 0xFFFF};
+constexpr size_t BOUNDARY_COUNT = sizeof(BOUNDARIES) / sizeof(BOUNDARIES[0]);
+
+// Ports named in filters (events also come from ports 6 and 7)
+constexpr uint32_t FILTER_PORTS = 6;
+constexpr uint32_t EVENT_PORTS = 8;
+
+// Naive match of one filter
+bool matches(const EventFilter& filter, const Event& event) {
+    return (filter.port == EventFilter::ANY_PORT || filter.port == event.port) &&
+           event.code >= filter.firstCode && event.code <= filter.lastCode &&
+           (filter.severities & EventFilter::severityBit(event.severity)) != 0;
+}
+
+/**
+ * Bus under test and the subscriptions it should hold
+ */
+class BusModel {
+public:
+    explicit BusModel(uint32_t seed)
+        : m_random(seed)
+        , m_action(nullptr)
+        , m_mismatches(0)
+        , m_published(0)
+        , m_delivered(0)
+        , m_nested(0) {
+    }
+
+    // Subscription changed from inside a handler while delivering
+    struct Action {
+        size_t actor;           // Subscriber whose handler makes the change
+        bool subscribe;         // Add a subscriber (else remove target)
+        size_t target;          // Subscriber to remove
+        EventFilter filter;     // Filter of the subscriber to add
+        bool done;              // Made (the actor ran)
+    };
+
+    EventFilter randomFilter() {
+        EventFilter filter;
+        if (m_random() % 3 != 0) {
+            filter.port = static_cast<uint16_t>(m_random() % FILTER_PORTS);
+        }
+        if (m_random() % 4 != 0) {
+            uint16_t first = BOUNDARIES[m_random() % BOUNDARY_COUNT];
+            uint16_t last = BOUNDARIES[m_random() % BOUNDARY_COUNT];
+            if (m_random() % 4 == 0) {
+                last = static_cast<uint16_t>(m_random());
+            }
+            filter.firstCode = (first < last) ? first : last;
+            filter.lastCode = (first < last) ? last : first;
+        }
+        if (m_random() % 2 != 0) {
+            filter.severities = static_cast<uint8_t>(m_random() & EventFilter::ALL_SEVERITIES);
+        }
+        return filter;
+    }
+
+    Event randomEvent(uint8_t* data) {
+        for (size_t i = 0; i < 3; i++) {
+            data[i] = static_cast<uint8_t>(m_random());
+        }
+        uint16_t code = static_cast<uint16_t>(m_random());
+        if (m_random() % 2 != 0) {
+            // On or next to a range boundary
+            code = static_cast<uint16_t>(BOUNDARIES[m_random() % BOUNDARY_COUNT] + m_random() % 3 - 1);
+        }
+        data[1] = static_cast<uint8_t>(code >> 8);
+        data[2] = static_cast<uint8_t>(code);
+
+        // Now and then a payload too short for a code (UNKNOWN severity)
+        size_t length = (m_random() % 50 == 0) ? m_random() % 3 : 3;
+        Event event;
+        decodeEvent(static_cast<uint8_t>(m_random() % EVENT_PORTS), data, length, event);
+        return event;
+    }
+
+    void subscribe(const EventFilter& filter) {
+        size_t index = m_subscribers.size();
+        uint32_t id = m_bus.subscribe(filter, [this, index](const Event& event) { handle(index, event); });
+        CHECK(id != EventBus::INVALID_SUBSCRIPTION);
+        m_subscribers.push_back(Subscriber{id, filter, true});
+    }
+
+    void unsubscribe(size_t index) {
+        CHECK(m_bus.unsubscribe(m_subscribers[index].id) == m_subscribers[index].active);
+        m_subscribers[index].active = false;
+    }
+
+    // Random active subscriber (or the size if there is none)
+    size_t randomActive() {
+        std::vector<size_t> active;
+        for (size_t index = 0; index < m_subscribers.size(); index++) {
+            if (m_subscribers[index].active) {
+                active.push_back(index);
+            }
+        }
+        return active.empty() ? m_subscribers.size() : active[m_random() % active.size()];
+    }
+
+    size_t activeCount() const {
+        size_t count = 0;
+        for (const Subscriber& subscriber : m_subscribers) {
+            count += subscriber.active ? 1 : 0;
+        }
+        return count;
+    }
+
+    // Publish an event, possibly with a change from inside a handler,
+    // and compare the deliveries with the model
+    void publish(const Event& event, Action* action) {
+        // Expected deliveries: the subscribers matching when publishing
+        // starts, minus those removed before their turn
+        std::vector<bool> active;
+        for (const Subscriber& subscriber : m_subscribers) {
+            active.push_back(subscriber.active);
+        }
+        std::vector<size_t> expected;
+        for (size_t index = 0; index < m_subscribers.size(); index++) {
+            if (!active[index] || !matches(m_subscribers[index].filter, event)) {
+                continue;
+            }
+            expected.push_back(index);
+            if (action && action->actor == index && !action->subscribe) {
+                active[action->target] = false;
+            }
+        }
+
+        m_calls.clear();
+        m_action = action;
+        size_t delivered = m_bus.publish(event);
+        m_action = nullptr;
+
+        if (m_calls != expected || delivered != expected.size()) {
+            m_mismatches++;
+        }
+        if (action && !expected.empty() && action->actor == expected.front()) {
+            CHECK(action->done);
+        }
+        CHECK(m_bus.getSubscriberCount() == activeCount());
+        m_published++;
+        m_delivered += delivered;
+    }
+
+    uint64_t getMismatches() const { return m_mismatches; }
+    uint64_t getPublished() const { return m_published; }
+    uint64_t getDelivered() const { return m_delivered; }
+    uint64_t getNested() const { return m_nested; }
+
+private:
+    struct Subscriber {
+        uint32_t id;            // Subscription ID
+        EventFilter filter;     // Filter
+        bool active;            // Not unsubscribed
+    };
+
+    EventBus m_bus;
+    std::mt19937 m_random;
+    std::vector<Subscriber> m_subscribers;  // In subscription order (never erased)
+    std::vector<size_t> m_calls;            // Handlers called for the current event
+    Action* m_action;                       // Change made while delivering
+    uint64_t m_mismatches;                  // Events delivered unlike the model
+    uint64_t m_published;                   // Events published
+    uint64_t m_delivered;                   // Handler calls
+    uint64_t m_nested;                      // Changes made from inside handlers
+
+    void handle(size_t index, const Event&) {
+        m_calls.push_back(index);
+        if (!m_action || m_action->actor != index || m_action->done) {
+            return;
+        }
+        m_action->done = true;
+        m_nested++;
+        if (m_action->subscribe) {
+            subscribe(m_action->filter);
+        } else {
+            unsubscribe(m_action->target);
+        }
+    }
+};
+
+// Random events and subscription changes against the naive match
+void checkRouting(uint32_t seed, size_t events) {
+    BusModel model(seed);
+    std::mt19937 random(seed);
+    for (size_t i = 0; i < 12; i++) {
+        model.subscribe(model.randomFilter());
+    }
+
+    uint8_t data[3];
+    for (size_t i = 0; i < events; i++) {
+        // Change the subscriptions between events now and then
+        if (random() % 20 == 0) {
+            size_t index = model.randomActive();
+            if (model.activeCount() < 8 || (model.activeCount() < 24 && random() % 2 != 0)) {
+                model.subscribe(model.randomFilter());
+            } else {
+                model.unsubscribe(index);
+            }
+        }
+
+        Event event = model.randomEvent(data);
+        if (random() % 4 != 0) {
+            model.publish(event, nullptr);
+            continue;
+        }
+
+        // Or from inside a handler: any subscriber may be the actor (it
+        // only acts if the event reaches it), removing itself, an earlier
+        // or a later subscriber or adding one
+        BusModel::Action action;
+        action.actor = model.randomActive();
+        action.subscribe = model.activeCount() < 8 || random() % 2 != 0;
+        action.target = model.randomActive();
+        action.filter = model.randomFilter();
+        action.done = false;
+        model.publish(event, &action);
+    }
+
+    CHECK(model.getMismatches() == 0);
+    printf("seed %u: %llu events, %llu deliveries, %llu changes in handlers, %llu mismatches\n", seed,
+           static_cast<unsigned long long>(model.getPublished()), static_cast<unsigned long long>(model.getDelivered()),
+           static_cast<unsigned long long>(model.getNested()), static_cast<unsigned long long>(model.getMismatches()));
+}
+
+// Subscriptions the bus refuses
+void checkInvalid() {
+    EventBus bus;
+    EventHandler handler = [](const Event&) {};
+    EventFilter filter;
+    CHECK(bus.subscribe(filter, EventHandler()) == EventBus::INVALID_SUBSCRIPTION);
+    filter.firstCode = 2;
+    filter.lastCode = 1;
+    CHECK(bus.subscribe(filter, handler) == EventBus::INVALID_SUBSCRIPTION);
+    filter = EventFilter();
+    filter.port = EventBus::MAX_PORT + 1;
+    CHECK(bus.subscribe(filter, handler) == EventBus::INVALID_SUBSCRIPTION);
+    filter.port = EventBus::MAX_PORT;
+    uint32_t id = bus.subscribe(filter, handler);
+    CHECK(id != EventBus::INVALID_SUBSCRIPTION);
+    CHECK(bus.getSubscriberCount() == 1);
+    CHECK(bus.unsubscribe(id));
+    CHECK(!bus.unsubscribe(id));
+    CHECK(bus.getSubscriberCount() == 0);
+}
+
+} // namespace
+
+int main() {
+    checkInvalid();
+
+    checkRouting(1, 50000);
+    checkRouting(2, 50000);
+    checkRouting(3, 50000);
+
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+/**
+ * @file event_queue_stress.cpp
+ * @brief Threaded stress test of EventQueue
+ *
+ * Producer threads push events carrying a per-producer sequence number
+ * in the code and payload while a consumer pops them. Events may be
+ * dropped when the small queues run full, but every producer's events
+ * must arrive in order with intact payloads, and every submitted event
+ * is either consumed or counted as dropped. The overflow policies are
+ * also checked directly on a full queue.
+ */
+
+#include "IOLinkEventQueue.h"
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace IOLink;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++;                                                         \
+        }                                                                       \
+    } while (0)
+
+// Let the other side run when no progress was made: spin a little on
+// multi-core machines, then sleep so a single core switches threads
+void backOff(unsigned& idle, size_t progress) {
+    if (progress > 0) {
+        idle = 0;
+    } else if (++idle < 64) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(20));
+    }
+}
+
+// Payload of a producer's event: the sequence number, then a few octets
+// derived from it (the length varies with the sequence number)
+size_t fillPayload(uint8_t producer, uint32_t sequence, uint8_t* data) {
+    size_t length = 4 + sequence % 5;
+    memcpy(data, &sequence, 4);
+    for (size_t i = 4; i < length; i++) {
+        data[i] = static_cast<uint8_t>(producer ^ (sequence * i));
+    }
+    return length;
+}
+
+// Event of a producer with its payload in data
+Event makeEvent(uint8_t producer, uint32_t sequence, uint8_t* data) {
+    Event event = {};
+    event.port = producer;
+    event.code = static_cast<uint16_t>(sequence);
+    event.data = data;
+    event.length = fillPayload(producer, sequence, data);
+    return event;
+}
+
+// Overflow behaviour of a full queue of capacity 4
+void checkPolicies() {
+    uint8_t data[MAX_PAYLOAD_LENGTH];
+    uint8_t buffer[MAX_PAYLOAD_LENGTH];
+    Event event;
+
+    // DROP_OLDEST: every push succeeds, the first two events make room
+    EventQueue<4> oldest(OverflowPolicy::DROP_OLDEST);
+    for (uint32_t sequence = 0; sequence < 6; sequence++) {
+        CHECK(oldest.push(makeEvent(0, sequence, data)));
+    }
+    CHECK(oldest.size() == 4);
+    CHECK(oldest.getDropCount() == 2);
+    CHECK(oldest.getHighWaterMark() == 4);
+    for (uint32_t sequence = 2; sequence < 6; sequence++) {
+        CHECK(oldest.pop(event, buffer));
+        CHECK(event.code == sequence);
+        CHECK(event.data == buffer);
+        CHECK(event.length == fillPayload(0, sequence, data));
+        CHECK(memcmp(event.data, data, event.length) == 0);
+    }
+    CHECK(!oldest.pop(event, buffer));
+    CHECK(oldest.empty());
+
+    // DROP_NEWEST: the last two pushes are refused
+    EventQueue<4> newest(OverflowPolicy::DROP_NEWEST);
+    for (uint32_t sequence = 0; sequence < 6; sequence++) {
+        CHECK(newest.push(makeEvent(0, sequence, data)) == (sequence < 4));
+    }
+    CHECK(newest.size() == 4);
+    CHECK(newest.getDropCount() == 2);
+    for (uint32_t sequence = 0; sequence < 4; sequence++) {
+        CHECK(newest.pop(event, buffer));
+        CHECK(event.code == sequence);
+        CHECK(event.length == fillPayload(0, sequence, data));
+        CHECK(memcmp(event.data, data, event.length) == 0);
+    }
+    CHECK(!newest.pop(event, buffer));
+
+    newest.resetStatistics();
+    CHECK(newest.getDropCount() == 0);
+    CHECK(newest.getHighWaterMark() == 0);
+}
+
+// Producers pushing perProducer events each while one thread consumes
+template <size_t Capacity>
+void checkThreaded(OverflowPolicy policy, size_t producers, uint32_t perProducer) {
+    EventQueue<Capacity> queue(policy);
+    std::atomic<size_t> finished(0);
+    std::atomic<uint64_t> refused(0);
+
+    std::vector<std::thread> threads;
+    for (size_t producer = 0; producer < producers; producer++) {
+        threads.emplace_back([&queue, &finished, &refused, producer, perProducer]() {
+            std::mt19937 random(static_cast<unsigned>(producer + 1));
+            uint8_t data[MAX_PAYLOAD_LENGTH];
+            uint64_t rejected = 0;
+            for (uint32_t sequence = 0; sequence < perProducer; sequence++) {
+                if (!queue.push(makeEvent(static_cast<uint8_t>(producer), sequence, data))) {
+                    rejected++;
+                }
+                if (random() % 16 == 0) {
+                    std::this_thread::yield();
+                }
+            }
+            refused.fetch_add(rejected);
+            finished.fetch_add(1);
+        });
+    }
+
+    std::vector<int64_t> last(producers, -1);
+    uint8_t buffer[MAX_PAYLOAD_LENGTH];
+    uint8_t expected[MAX_PAYLOAD_LENGTH];
+    uint64_t consumed = 0;
+    uint64_t disorders = 0;
+    uint64_t mismatches = 0;
+    unsigned idle = 0;
+    while (true) {
+        bool done = finished.load() == producers;
+        Event event;
+        if (!queue.pop(event, buffer)) {
+            if (done) {
+                break;
+            }
+            backOff(idle, 0);
+            continue;
+        }
+        backOff(idle, 1);
+        consumed++;
+
+        uint32_t sequence;
+        memcpy(&sequence, event.data, 4);
+        if (event.port >= producers || static_cast<int64_t>(sequence) <= last[event.port]) {
+            disorders++;
+            continue;
+        }
+        last[event.port] = sequence;
+        if (event.code != static_cast<uint16_t>(sequence) ||
+            event.length != fillPayload(event.port, sequence, expected) ||
+            memcmp(event.data, expected, event.length) != 0) {
+            mismatches++;
+        }
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    uint64_t submitted = static_cast<uint64_t>(producers) * perProducer;
+    CHECK(disorders == 0);
+    CHECK(mismatches == 0);
+    CHECK(consumed + queue.getDropCount() == submitted);
+    if (policy == OverflowPolicy::DROP_NEWEST) {
+        CHECK(refused.load() == queue.getDropCount());
+    } else {
+        CHECK(refused.load() <= queue.getDropCount());
+    }
+    CHECK(queue.getHighWaterMark() <= Capacity);
+    CHECK(queue.empty());
+    printf("queue %zu %s: %zu producers, %llu events, %llu consumed, %u dropped\n", Capacity,
+           policy == OverflowPolicy::DROP_OLDEST ? "drop oldest" : "drop newest", producers,
+           static_cast<unsigned long long>(submitted), static_cast<unsigned long long>(consumed),
+           queue.getDropCount());
+}
+
+} // namespace
+
+int main() {
+    checkPolicies();
+
+    checkThreaded<4>(OverflowPolicy::DROP_OLDEST, 4, 200000);
+    checkThreaded<4>(OverflowPolicy::DROP_NEWEST, 4, 200000);
+    checkThreaded<64>(OverflowPolicy::DROP_OLDEST, 8, 100000);
+    checkThreaded<64>(OverflowPolicy::DROP_NEWEST, 8, 100000);
+
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
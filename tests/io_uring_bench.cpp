@@ -0,0 +1,180 @@
+/**
+ * @file io_uring_bench.cpp
+ * @brief System calls per cycle of the io_uring backend and the termios path
+ *
+ * Eight simulated devices on pseudo-terminals exchange process data with
+ * the master; every cycle submits a request to each port through a
+ * TransactionManager and runs it to completion. The same cycle is run
+ * over PosixSerialTransport (one system call per write, ppoll, FIONREAD
+ * and read) and over IoUringTransport (io_uring_enter() calls counted
+ * by the context). The benchmark fails if the io_uring backend needs
+ * as many system calls as the termios path.
+ */
+
+#include "IOLink.h"
+#include "IOLinkPosix.h"
+#include "IOLinkSimulator.h"
+#include "IOLinkTransaction.h"
+#if defined(IOLINK_USE_IO_URING)
+#include "IOLinkIoUring.h"
+#endif
+#include <stdio.h>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace IOLink;
+
+namespace {
+
+using BenchClock = std::chrono::steady_clock;
+
+constexpr size_t PORT_COUNT = 8;
+constexpr size_t CYCLES = 500;
+constexpr uint32_t BAUD_RATE = 230400;
+
+// Termios transport counting its system calls (each call below is one)
+class CountingSerialTransport : public PosixSerialTransport {
+public:
+    explicit CountingSerialTransport(const char* devicePath, uint64_t& count)
+        : PosixSerialTransport(devicePath)
+        , m_count(count) {
+    }
+
+    size_t available() override {
+        m_count++;
+        return PosixSerialTransport::available();
+    }
+
+    size_t read(uint8_t* buffer, size_t length) override {
+        m_count++;
+        return PosixSerialTransport::read(buffer, length);
+    }
+
+    size_t write(const uint8_t* data, size_t length) override {
+        m_count++;
+        return PosixSerialTransport::write(data, length);
+    }
+
+    ErrorCode waitReadable(uint32_t timeoutUs) override {
+        m_count++;
+        return PosixSerialTransport::waitReadable(timeoutUs);
+    }
+
+private:
+    uint64_t& m_count;
+};
+
+struct Result {
+    double cycleUs;         // Mean cycle time
+    double syscalls;        // System calls per cycle
+    size_t failures;        // Transactions without a reply
+};
+
+// Run the cycles over the given transports; syscalls() reads the counter
+template <typename Counter>
+Result runCycles(std::vector<Transport*>& transports, Counter syscalls) {
+    PosixClock clock;
+    IOLinkMaster master(*transports[0], clock);
+    for (size_t port = 1; port < transports.size(); port++) {
+        master.addPort(*transports[port]);
+    }
+    master.configure(BAUD_RATE);
+    master.setTransmitQueue(true);
+    master.scanForDevices();
+
+    TransactionManager transactions(master);
+    uint8_t output[2] = {0x12, 0x34};
+    size_t failures = 0;
+    auto check = [&failures](uint8_t, ErrorCode result, const FrameView&) {
+        if (result != ErrorCode::NONE) {
+            failures++;
+        }
+    };
+
+    // One warm-up cycle (arms the reads of the io_uring backend)
+    for (size_t port = 0; port < transports.size(); port++) {
+        transactions.submit(static_cast<uint8_t>(port), MessageType::PROCESS_DATA, output, sizeof(output), check);
+    }
+    transactions.run();
+    failures = 0;
+
+    uint64_t before = syscalls();
+    auto start = BenchClock::now();
+    for (size_t cycle = 0; cycle < CYCLES; cycle++) {
+        for (size_t port = 0; port < transports.size(); port++) {
+            transactions.submit(static_cast<uint8_t>(port), MessageType::PROCESS_DATA, output, sizeof(output), check);
+        }
+        transactions.run();
+    }
+    double elapsed = std::chrono::duration<double, std::micro>(BenchClock::now() - start).count();
+
+    return Result{elapsed / CYCLES, static_cast<double>(syscalls() - before) / CYCLES, failures};
+}
+
+void report(const char* name, const Result& result) {
+    printf("%-10s %10.1f %14.1f %9zu\n", name, result.cycleUs, result.syscalls, result.failures);
+}
+
+} // namespace
+
+int main() {
+    DeviceSimulator simulator;
+    std::vector<std::unique_ptr<SimulatedDevice>> devices;
+    for (size_t i = 0; i < PORT_COUNT; i++) {
+        devices.emplace_back(new SimulatedDevice(2));
+        size_t index;
+        if (simulator.addDevice(*devices.back(), index) != ErrorCode::NONE) {
+            printf("cannot create pseudo-terminals\n");
+            return 1;
+        }
+    }
+    simulator.start();
+
+    printf("%zu ports, %zu cycles\n", PORT_COUNT, CYCLES);
+    printf("%-10s %10s %14s %9s\n", "path", "cycle us", "syscalls/cycle", "failures");
+    Result termios;
+
+    // termios path
+    {
+        uint64_t count = 0;
+        std::vector<std::unique_ptr<CountingSerialTransport>> ports;
+        std::vector<Transport*> transports;
+        for (size_t i = 0; i < PORT_COUNT; i++) {
+            ports.emplace_back(new CountingSerialTransport(simulator.getDevicePath(i), count));
+            transports.push_back(ports.back().get());
+        }
+        termios = runCycles(transports, [&count]() { return count; });
+        report("termios", termios);
+    }
+
+#if defined(IOLINK_USE_IO_URING)
+    // io_uring backend
+    {
+        IoUringContext uring;
+        if (uring.open(PORT_COUNT) != ErrorCode::NONE) {
+            printf("io_uring not available\n");
+            return 0;
+        }
+
+        std::vector<std::unique_ptr<IoUringTransport>> ports;
+        std::vector<Transport*> transports;
+        for (size_t i = 0; i < PORT_COUNT; i++) {
+            ports.emplace_back(new IoUringTransport(uring, simulator.getDevicePath(i)));
+            transports.push_back(ports.back().get());
+        }
+        Result result = runCycles(transports, [&uring]() { return uring.getEnterCount(); });
+        report("io_uring", result);
+        printf("(%s reads)\n", uring.usesMultishot() ? "multishot" : "single-shot");
+        if (result.failures > 0 || termios.failures > 0 || result.syscalls >= termios.syscalls) {
+            printf("FAIL\n");
+            return 1;
+        }
+    }
+#else
+    printf("io_uring   built without IOLINK_USE_IO_URING\n");
+#endif
+
+    simulator.stop();
+    return 0;
+}
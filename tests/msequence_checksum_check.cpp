@@ -0,0 +1,286 @@
+/**
+ * @file msequence_checksum_check.cpp
+ * @brief M-sequence checksum and length limits
+ *
+ * mSequenceChecksum() (XOR kernel plus compression table) is compared
+ * with a bit-by-bit reference of the IEC 61131-9 CKT/CKS checksum for
+ * every one- and two-octet input and for encoded master and device
+ * messages of the predefined and the largest variable types; every
+ * single bit error in those messages must be rejected. The largest
+ * valid configuration is accepted by setFraming() and exchanged through
+ * the master, the next larger ones are refused.
+ */
+
+#include "IOLink.h"
+#include "IOLinkMSequence.h"
+#include "IOLinkPosix.h"
+#include <stdio.h>
+#include <string.h>
+#include <deque>
+#include <random>
+
+using namespace IOLink;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++;                                                         \
+        }                                                                       \
+    } while (0)
+
+// Checksum bits of the CKT and CKS octets
+constexpr uint8_t CHECKSUM_MASK = 0x3F;
+
+// Bit n of an octet
+unsigned bit(uint8_t value, unsigned n) {
+    return (value >> n) & 1u;
+}
+
+// IEC 61131-9 checksum computed bit by bit: each bit of the 8-bit
+// checksum is the parity of that bit over the seed 0x52 and all
+// octets, then pairs and alternate bits are folded into 6 bits
+uint8_t referenceChecksum(const uint8_t* data, size_t length) {
+    unsigned d[8];
+    for (unsigned n = 0; n < 8; n++) {
+        d[n] = bit(0x52, n);
+        for (size_t i = 0; i < length; i++) {
+            d[n] ^= bit(data[i], n);
+        }
+    }
+    unsigned c5 = d[7] ^ d[5] ^ d[3] ^ d[1];
+    unsigned c4 = d[6] ^ d[4] ^ d[2] ^ d[0];
+    unsigned c3 = d[7] ^ d[6];
+    unsigned c2 = d[5] ^ d[4];
+    unsigned c1 = d[3] ^ d[2];
+    unsigned c0 = d[1] ^ d[0];
+    return static_cast<uint8_t>((c5 << 5) | (c4 << 4) | (c3 << 3) | (c2 << 2) | (c1 << 1) | c0);
+}
+
+// Every one- and two-octet input
+void checkShortInputs() {
+    uint64_t mismatches = 0;
+    uint8_t data[2];
+    for (unsigned first = 0; first < 256; first++) {
+        data[0] = static_cast<uint8_t>(first);
+        if (mSequenceChecksum(data, 1) != referenceChecksum(data, 1)) {
+            mismatches++;
+        }
+        for (unsigned second = 0; second < 256; second++) {
+            data[1] = static_cast<uint8_t>(second);
+            if (mSequenceChecksum(data, 2) != referenceChecksum(data, 2)) {
+                mismatches++;
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(mSequenceChecksum(data, 0) == referenceChecksum(data, 0));
+}
+
+// Encoded messages of a configuration: checksum against the reference,
+// and every single bit error rejected
+void checkMessages(const MSequenceConfig& config, std::mt19937& random) {
+    uint8_t pdOut[MSEQ_MAX_PD_LENGTH];
+    uint8_t pdIn[MSEQ_MAX_PD_LENGTH];
+    uint8_t od[MSEQ_MAX_OD_LENGTH];
+    for (size_t i = 0; i < MSEQ_MAX_PD_LENGTH; i++) {
+        pdOut[i] = static_cast<uint8_t>(random());
+        pdIn[i] = static_cast<uint8_t>(random());
+    }
+    for (size_t i = 0; i < MSEQ_MAX_OD_LENGTH; i++) {
+        od[i] = static_cast<uint8_t>(random());
+    }
+
+    for (int read = 0; read < 2; read++) {
+        uint8_t buffer[MSEQ_MAX_LENGTH];
+        uint8_t cleared[MSEQ_MAX_LENGTH];
+
+        MasterMessage request = {};
+        request.read = read != 0;
+        request.channel = static_cast<Channel>(random() % 4);
+        request.address = static_cast<uint8_t>(random() % 32);
+        request.pdOut = pdOut;
+        request.od = od;
+        size_t length = encodeMasterMessage(config, request, buffer, sizeof(buffer));
+        CHECK(length == config.masterLength(request.read));
+        memcpy(cleared, buffer, length);
+        cleared[1] &= ~CHECKSUM_MASK;
+        CHECK((buffer[1] & CHECKSUM_MASK) == referenceChecksum(cleared, length));
+
+        MasterMessage decodedRequest;
+        CHECK(decodeMasterMessage(config, buffer, length, decodedRequest) == ErrorCode::NONE);
+        for (size_t position = 0; position < length * 8; position++) {
+            buffer[position / 8] ^= static_cast<uint8_t>(1u << (position % 8));
+            CHECK(decodeMasterMessage(config, buffer, length, decodedRequest) != ErrorCode::NONE);
+            buffer[position / 8] ^= static_cast<uint8_t>(1u << (position % 8));
+        }
+
+        DeviceMessage reply = {};
+        reply.od = od;
+        reply.pdIn = pdIn;
+        reply.eventFlag = (random() & 1) != 0;
+        reply.pdValid = (random() & 1) != 0;
+        length = encodeDeviceMessage(config, request.read, reply, buffer, sizeof(buffer));
+        CHECK(length == config.deviceLength(request.read));
+        memcpy(cleared, buffer, length);
+        cleared[length - 1] &= ~CHECKSUM_MASK;
+        CHECK((buffer[length - 1] & CHECKSUM_MASK) == referenceChecksum(cleared, length));
+
+        DeviceMessage decodedReply;
+        CHECK(decodeDeviceMessage(config, request.read, buffer, length, decodedReply) == ErrorCode::NONE);
+        CHECK(decodedReply.eventFlag == reply.eventFlag);
+        CHECK(decodedReply.pdValid == reply.pdValid);
+        for (size_t position = 0; position < length * 8; position++) {
+            buffer[position / 8] ^= static_cast<uint8_t>(1u << (position % 8));
+            CHECK(decodeDeviceMessage(config, request.read, buffer, length, decodedReply) != ErrorCode::NONE);
+            buffer[position / 8] ^= static_cast<uint8_t>(1u << (position % 8));
+        }
+    }
+}
+
+/**
+ * Transport answering each master message like a device of one
+ * M-sequence type, with fixed OD and PDin contents
+ */
+class DeviceStub : public Transport {
+public:
+    explicit DeviceStub(const MSequenceConfig& config)
+        : m_config(config) {
+        for (size_t i = 0; i < sizeof(m_od); i++) {
+            m_od[i] = static_cast<uint8_t>(0xA0 + i);
+        }
+        for (size_t i = 0; i < sizeof(m_pdIn); i++) {
+            m_pdIn[i] = static_cast<uint8_t>(0x40 + i);
+        }
+    }
+
+    ErrorCode configure(uint32_t) override { return ErrorCode::NONE; }
+    size_t available() override { return m_reply.size(); }
+
+    int readByte() override {
+        if (m_reply.empty()) {
+            return -1;
+        }
+        int byte = m_reply.front();
+        m_reply.pop_front();
+        return byte;
+    }
+
+    bool writeByte(uint8_t byte) override { return write(&byte, 1) == 1; }
+
+    size_t write(const uint8_t* data, size_t length) override {
+        MasterMessage request;
+        if (decodeMasterMessage(m_config, data, length, request) != ErrorCode::NONE) {
+            return length;
+        }
+
+        DeviceMessage reply = {};
+        reply.od = m_od;
+        reply.pdIn = m_pdIn;
+        reply.pdValid = true;
+        uint8_t buffer[MSEQ_MAX_LENGTH];
+        size_t replyLength = encodeDeviceMessage(m_config, request.read, reply, buffer, sizeof(buffer));
+        m_reply.insert(m_reply.end(), buffer, buffer + replyLength);
+        m_requests++;
+        return length;
+    }
+
+    const uint8_t* getOd() const { return m_od; }
+    const uint8_t* getPdIn() const { return m_pdIn; }
+    size_t getRequests() const { return m_requests; }
+
+private:
+    MSequenceConfig m_config;
+    uint8_t m_od[MSEQ_MAX_OD_LENGTH];
+    uint8_t m_pdIn[MSEQ_MAX_PD_LENGTH];
+    std::deque<uint8_t> m_reply;
+    size_t m_requests = 0;
+};
+
+// Octet counts at the limits: the largest configuration is accepted and
+// its longest messages fit the master's buffers, one octet more is refused
+void checkLimits() {
+    const MSequenceConfig largest = makeType2V(MSEQ_MAX_OD_LENGTH, MSEQ_MAX_PD_LENGTH, MSEQ_MAX_PD_LENGTH);
+    const MSequenceConfig tooLarge[] = {
+        makeType2V(MSEQ_MAX_OD_LENGTH + 1, MSEQ_MAX_PD_LENGTH, MSEQ_MAX_PD_LENGTH),
+        makeType2V(MSEQ_MAX_OD_LENGTH, MSEQ_MAX_PD_LENGTH + 1, MSEQ_MAX_PD_LENGTH),
+        makeType2V(MSEQ_MAX_OD_LENGTH, MSEQ_MAX_PD_LENGTH, MSEQ_MAX_PD_LENGTH + 1),
+        makeType1V(MSEQ_MAX_OD_LENGTH + 1),
+        makeType2V(255, 255, 255)
+    };
+
+    CHECK(largest.isValid());
+    CHECK(makeType1V(MSEQ_MAX_OD_LENGTH).isValid());
+    CHECK(largest.masterLength(false) == MSEQ_MAX_LENGTH);
+    CHECK(largest.deviceLength(true) <= MSEQ_MAX_LENGTH);
+
+    DeviceStub device(largest);
+    PosixClock clock;
+    IOLinkMaster master(device, clock);
+    CHECK(master.scanForDevices() == ErrorCode::NONE);
+    for (const MSequenceConfig& config : tooLarge) {
+        CHECK(!config.isValid());
+        CHECK(master.setFraming(Framing::M_SEQUENCE, config) == ErrorCode::INVALID_PARAMETER);
+        CHECK(master.getFraming() == Framing::SIMPLE);
+    }
+    CHECK(master.setFraming(Framing::M_SEQUENCE, largest) == ErrorCode::NONE);
+    CHECK(master.getFraming() == Framing::M_SEQUENCE);
+
+    // Longest request (write) and longest reply (read)
+    uint8_t pdOut[MSEQ_MAX_PD_LENGTH];
+    uint8_t od[MSEQ_MAX_OD_LENGTH];
+    memset(pdOut, 0x5A, sizeof(pdOut));
+    memset(od, 0xC3, sizeof(od));
+    for (int read = 0; read < 2; read++) {
+        MasterMessage request = {};
+        request.read = read != 0;
+        request.channel = Channel::ISDU;
+        request.address = 0x10;
+        request.pdOut = pdOut;
+        request.od = od;
+        DeviceMessage response = {};
+        CHECK(master.exchangeMSequence(0, request, response, 100) == ErrorCode::NONE);
+        CHECK(response.pdIn != nullptr && memcmp(response.pdIn, device.getPdIn(), MSEQ_MAX_PD_LENGTH) == 0);
+        if (request.read) {
+            CHECK(response.od != nullptr && memcmp(response.od, device.getOd(), MSEQ_MAX_OD_LENGTH) == 0);
+        }
+        CHECK(response.pdValid);
+    }
+    CHECK(device.getRequests() == 2);
+
+    // A refused configuration leaves the previous one in place
+    CHECK(master.setFraming(Framing::M_SEQUENCE, tooLarge[0]) == ErrorCode::INVALID_PARAMETER);
+    MasterMessage request = {};
+    request.read = true;
+    request.pdOut = pdOut;
+    DeviceMessage response = {};
+    CHECK(master.exchangeMSequence(0, request, response, 100) == ErrorCode::NONE);
+    CHECK(device.getRequests() == 3);
+}
+
+} // namespace
+
+int main() {
+    checkShortInputs();
+
+    std::mt19937 random(1);
+    const MSequenceConfig configs[] = {
+        MSEQ_TYPE_0, MSEQ_TYPE_1_1, MSEQ_TYPE_1_2, MSEQ_TYPE_2_1, MSEQ_TYPE_2_2,
+        MSEQ_TYPE_2_3, MSEQ_TYPE_2_4, MSEQ_TYPE_2_5, makeType1V(8), makeType1V(32),
+        makeType2V(1, 32, 32), makeType2V(32, 32, 32)
+    };
+    for (const MSequenceConfig& config : configs) {
+        for (int round = 0; round < 16; round++) {
+            checkMessages(config, random);
+        }
+    }
+
+    checkLimits();
+
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file port_hangup_check.cpp
+ * @brief EpollReactor drops a port whose device hangs up
+ *
+ * The simulated device's pseudo-terminal is closed while the reactor
+ * serves the port, as when a USB serial adapter is unplugged. The hangup
+ * must be reported once and the reactor must block again afterwards
+ * instead of dispatching the level-triggered fd forever.
+ */
+
+#include "IOLink.h"
+#include "IOLinkEpollReactor.h"
+#include "IOLinkPosix.h"
+#include "IOLinkSimulator.h"
+#include <stdio.h>
+#include <chrono>
+#include <memory>
+
+using namespace IOLink;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++;                                                         \
+        }                                                                       \
+    } while (0)
+
+using BenchClock = std::chrono::steady_clock;
+
+constexpr int IDLE_WAIT_MS = 50;
+
+} // namespace
+
+int main() {
+    std::unique_ptr<DeviceSimulator> simulator(new DeviceSimulator());
+    SimulatedDevice device(2);
+    size_t index;
+    if (simulator->addDevice(device, index) != ErrorCode::NONE) {
+        printf("cannot create pseudo-terminals\n");
+        return 1;
+    }
+    simulator->start();
+
+    PosixSerialTransport port(simulator->getDevicePath(index));
+    PosixClock clock;
+    IOLinkMaster master(port, clock);
+    master.configure(COM3_BAUD_RATE);
+    master.scanForDevices();
+
+    EpollReactor reactor;
+    size_t frames = 0;
+    int lostCount = 0;
+    int lostPort = -1;
+    master.registerFrameCallback([&frames](uint8_t, const FrameView&) { frames++; });
+    CHECK(reactor.addPort(master, 0, port.getFd(), [&lostCount, &lostPort](uint8_t lost) {
+        lostCount++;
+        lostPort = lost;
+    }) == ErrorCode::NONE);
+
+    // The port is served while the device is there
+    uint8_t output[2] = {0x12, 0x34};
+    CHECK(master.writeProcessData(0, output, sizeof(output)) == ErrorCode::NONE);
+    auto until = BenchClock::now() + std::chrono::milliseconds(500);
+    while (frames == 0 && BenchClock::now() < until) {
+        reactor.runOnce(IDLE_WAIT_MS);
+    }
+    CHECK(frames == 1);
+    CHECK(lostCount == 0);
+
+    // Unplug: the master side of the pseudo-terminal goes away
+    simulator.reset();
+    size_t dispatched = reactor.runOnce(500);
+    CHECK(dispatched == 1);
+    CHECK(lostCount == 1);
+    CHECK(lostPort == 0);
+
+    // The fd is no longer ready-forever: the reactor blocks for the timeout
+    auto start = BenchClock::now();
+    dispatched = 0;
+    for (int i = 0; i < 3; i++) {
+        dispatched += reactor.runOnce(IDLE_WAIT_MS);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(BenchClock::now() - start).count();
+    CHECK(dispatched == 0);
+    CHECK(elapsed >= 3 * IDLE_WAIT_MS - 5);
+    CHECK(lostCount == 1);
+
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
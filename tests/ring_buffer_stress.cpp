@@ -0,0 +1,172 @@
+/**
+ * @file ring_buffer_stress.cpp
+ * @brief Threaded stress test of SpscRingBuffer
+ *
+ * A producer thread writes a known byte sequence in random chunk sizes,
+ * alternating between push() and writeBuffer()/commit(); the consumer
+ * reads it back in random chunk sizes with pop() and checks every byte.
+ * The small rings wrap around every few chunks and are full or empty
+ * most of the time. The full/empty edges are also checked directly.
+ */
+
+#include "IOLinkRingBuffer.h"
+#include <stdio.h>
+#include <chrono>
+#include <random>
+#include <thread>
+
+using namespace IOLink;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++;                                                         \
+        }                                                                       \
+    } while (0)
+
+// Byte at a position of the test sequence (not periodic in any ring size)
+uint8_t patternByte(uint64_t position) {
+    return static_cast<uint8_t>(position ^ (position >> 8) ^ (position >> 16) ^ (position * 0x9E));
+}
+
+// Let the other side run when no progress was made: spin a little on
+// multi-core machines, then sleep so a single core switches threads
+void backOff(unsigned& idle, size_t progress) {
+    if (progress > 0) {
+        idle = 0;
+    } else if (++idle < 64) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(20));
+    }
+}
+
+// Edges of a ring: empty, exactly full, partial writes when full, wrap point
+template <size_t Capacity>
+void checkEdges() {
+    SpscRingBuffer<Capacity> ring;
+    uint8_t data[2 * Capacity];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = patternByte(i);
+    }
+
+    CHECK(ring.empty());
+    CHECK(ring.pop() == -1);
+    CHECK(ring.pop(data, sizeof(data)) == 0);
+    CHECK(ring.space() == Capacity);
+
+    // Fill exactly, then one more byte does not fit
+    CHECK(ring.push(data, Capacity) == Capacity);
+    CHECK(ring.space() == 0);
+    CHECK(ring.size() == Capacity);
+    CHECK(!ring.push(0xFF));
+    size_t space = 1;
+    ring.writeBuffer(space);
+    CHECK(space == 0);
+
+    // Drain all but one byte, then refill across the wrap point
+    uint8_t out[2 * Capacity];
+    CHECK(ring.pop(out, Capacity - 1) == Capacity - 1);
+    CHECK(ring.size() == 1);
+    CHECK(ring.push(data + Capacity, Capacity) == Capacity - 1);
+
+    // The contiguous area at the wrap point stops at the end of the storage
+    CHECK(ring.pop(out + Capacity - 1, 2 * Capacity) == Capacity);
+    CHECK(ring.empty());
+    for (size_t i = 0; i < 2 * Capacity - 1; i++) {
+        CHECK(out[i] == data[i]);
+    }
+    ring.writeBuffer(space);
+    CHECK(space == 1);
+    ring.commit(0);
+
+    // Byte-wise access around the wrap point
+    for (size_t i = 0; i < 3 * Capacity; i++) {
+        CHECK(ring.push(static_cast<uint8_t>(i)));
+        CHECK(ring.pop() == static_cast<int>(i & 0xFF));
+    }
+    CHECK(ring.empty());
+}
+
+// Producer and consumer threads moving total bytes through the ring
+template <size_t Capacity>
+void checkThreaded(uint64_t total, size_t maxChunk) {
+    SpscRingBuffer<Capacity> ring;
+
+    std::thread producer([&ring, total, maxChunk]() {
+        std::mt19937 random(1);
+        uint8_t chunk[4096];
+        uint64_t position = 0;
+        unsigned idle = 0;
+        while (position < total) {
+            size_t length = 1 + random() % maxChunk;
+            if (length > total - position) {
+                length = static_cast<size_t>(total - position);
+            }
+
+            if (random() & 1) {
+                for (size_t i = 0; i < length; i++) {
+                    chunk[i] = patternByte(position + i);
+                }
+                size_t stored = ring.push(chunk, length);
+                backOff(idle, stored);
+                position += stored;
+            } else {
+                size_t space;
+                uint8_t* buffer = ring.writeBuffer(space);
+                if (space > length) {
+                    space = length;
+                }
+                for (size_t i = 0; i < space; i++) {
+                    buffer[i] = patternByte(position + i);
+                }
+                ring.commit(space);
+                backOff(idle, space);
+                position += space;
+            }
+        }
+    });
+
+    std::mt19937 random(2);
+    uint8_t chunk[4096];
+    uint64_t position = 0;
+    uint64_t mismatches = 0;
+    unsigned idle = 0;
+    while (position < total) {
+        size_t length = ring.pop(chunk, 1 + random() % maxChunk);
+        backOff(idle, length);
+        for (size_t i = 0; i < length; i++) {
+            if (chunk[i] != patternByte(position + i)) {
+                mismatches++;
+            }
+        }
+        position += length;
+    }
+    producer.join();
+
+    CHECK(mismatches == 0);
+    CHECK(position == total);
+    CHECK(ring.empty());
+    printf("ring %zu: %llu bytes, chunks up to %zu, %llu mismatches\n", Capacity,
+           static_cast<unsigned long long>(total), maxChunk, static_cast<unsigned long long>(mismatches));
+}
+
+} // namespace
+
+int main() {
+    checkEdges<2>();
+    checkEdges<64>();
+    checkEdges<4096>();
+
+    checkThreaded<2>(1 << 20, 3);
+    checkThreaded<64>(16 << 20, 100);
+    checkThreaded<4096>(64 << 20, 4096);
+
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file stale_reply_check.cpp
+ * @brief A late reply is not taken for the reply to the next request
+ *
+ * A simulated device answers parameter requests after its receive call
+ * has given up. The late reply is read while the master waits for
+ * process data and queued for the parameter reader; sending the next
+ * parameter request must drop it, so that request gets its own reply.
+ */
+
+#include "IOLink.h"
+#include "IOLinkPosix.h"
+#include "IOLinkSimulator.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+
+using namespace IOLink;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++;                                                         \
+        }                                                                       \
+    } while (0)
+
+constexpr int PARAMETER_DELAY_MS = 30;
+
+// Echoes parameter requests late, answers process data at once
+class SlowParameterDevice : public SimulatedDevice {
+public:
+    bool onFrame(const FrameView& request, MessageType& replyType, uint8_t* reply, size_t& replyLength) override {
+        if (request.type != MessageType::PARAMETER) {
+            return SimulatedDevice::onFrame(request, replyType, reply, replyLength);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(PARAMETER_DELAY_MS));
+        replyType = MessageType::PARAMETER;
+        memcpy(reply, request.data, request.length);
+        replyLength = request.length;
+        return true;
+    }
+};
+
+} // namespace
+
+int main() {
+    DeviceSimulator simulator;
+    simulator.setPacing(false);
+    SlowParameterDevice device;
+    size_t index;
+    if (simulator.addDevice(device, index) != ErrorCode::NONE) {
+        printf("cannot create pseudo-terminals\n");
+        return 1;
+    }
+    simulator.start();
+
+    PosixSerialTransport port(simulator.getDevicePath(index));
+    PosixClock clock;
+    IOLinkMaster master(port, clock);
+    master.configure(COM3_BAUD_RATE);
+    master.scanForDevices();
+
+    // The first request times out before its reply arrives
+    uint8_t first = 1;
+    FrameView frame;
+    CHECK(master.sendMessage(0, MessageType::PARAMETER, &first, 1) == ErrorCode::NONE);
+    CHECK(master.receiveMessage(0, MessageType::PARAMETER, frame, PARAMETER_DELAY_MS / 4) == ErrorCode::TIMEOUT);
+
+    // The late reply is read and queued while waiting for process data
+    std::this_thread::sleep_for(std::chrono::milliseconds(2 * PARAMETER_DELAY_MS));
+    uint8_t output[2] = {0x12, 0x34};
+    CHECK(master.writeProcessData(0, output, sizeof(output)) == ErrorCode::NONE);
+    CHECK(master.readProcessData(0, frame, 100) == ErrorCode::NONE);
+
+    // The second request gets its own reply, not the queued one
+    uint8_t second = 2;
+    CHECK(master.sendMessage(0, MessageType::PARAMETER, &second, 1) == ErrorCode::NONE);
+    CHECK(master.receiveMessage(0, MessageType::PARAMETER, frame, 4 * PARAMETER_DELAY_MS) == ErrorCode::NONE);
+    CHECK(frame.length == 1 && frame.data[0] == second);
+
+    simulator.stop();
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}